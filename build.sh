@@ -1,5 +1,7 @@
 #!/bin/bash
 
+set -e
+
 ARCHITECTURE=$1
 LIB_DIR=$2
 
@@ -12,17 +14,18 @@ USR_DIR="${PACKAGE_DIR}/usr"
 INCLUDE_DIR="${USR_DIR}/src"
 BUILD_DIR="dist/build"
 SO_FILE="${BUILD_DIR}/libdiwa.so"
+BIN_FILE="${BUILD_DIR}/diwa"
 
 case "$ARCHITECTURE" in
     amd64)
         CROSS_COMPILE="g++ -fPIC"
         ;;
     riscv64)
-        CROSS_COMPILE="riscv64-linux-gnu-gcc"
+        CROSS_COMPILE="riscv64-linux-gnu-g++ -fPIC"
         ;;
     armhf)
         export PATH="/usr/lib/gcc/arm-none-eabi/13.2.1:$PATH"
-        CROSS_COMPILE="arm-linux-gnueabihf-cpp"
+        CROSS_COMPILE="arm-linux-gnueabihf-g++ -fPIC"
         ;;
     *)
         echo -e "\033[93m[-]\033[0m Unsupported architecture: $ARCHITECTURE"
@@ -33,13 +36,18 @@ esac
 mkdir -p "${DEBIAN_DIR}"
 mkdir -p "${INCLUDE_DIR}/diwa"
 mkdir -p "${USR_DIR}/lib/${LIB_DIR}"
+mkdir -p "${USR_DIR}/bin"
 mkdir -p "${BUILD_DIR}"
 
 echo -e "\033[92m[+]\033[0m Building shared library for ${ARCHITECTURE}..."
 ${CROSS_COMPILE} -shared -o "${SO_FILE}" -Isrc src/*.cpp
 
+echo -e "\033[92m[+]\033[0m Building command-line tool for ${ARCHITECTURE}..."
+${CROSS_COMPILE} -o "${BIN_FILE}" -Isrc src/*.cpp tools/diwa/diwa.cpp -pthread
+
 cp -r src/diwa.h "${INCLUDE_DIR}/"
 cp "${SO_FILE}" "${USR_DIR}/lib/${LIB_DIR}/"
+cp "${BIN_FILE}" "${USR_DIR}/bin/"
 
 cat <<EOF > "${DEBIAN_DIR}/control"
 Package: diwa
@@ -59,6 +67,7 @@ chmod 755 "${DEBIAN_DIR}"
 chmod 755 "${USR_DIR}"
 chmod 755 "${INCLUDE_DIR}"
 chmod 755 "${USR_DIR}/lib/${LIB_DIR}"
+chmod 755 "${USR_DIR}/bin/diwa"
 
 dpkg-deb --build "${PACKAGE_DIR}" > /dev/null
 
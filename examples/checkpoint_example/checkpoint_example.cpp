@@ -0,0 +1,146 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_trainer.h>
+#include <fstream>
+#include <iostream>
+#include <string.h>
+
+using namespace std;
+
+#define TRAINING_SAMPLES    300
+#define VALIDATION_SAMPLES  100
+#define EPOCHS              200
+#define PREEMPTED_STEP      17450
+
+static double inputs[TRAINING_SAMPLES + VALIDATION_SAMPLES][2];
+static double outputs[TRAINING_SAMPLES + VALIDATION_SAMPLES][1];
+
+// Configures a network and its trainer identically on every run
+static void configure(Diwa& network, DiwaTrainer& trainer) {
+    network.setSeed(1);
+    network.initialize(2, 1, 8, 1);
+    network.setUpdateThreshold(1e-3);
+
+    trainer.setLearningRate(2.0);
+    trainer.setCosineSchedule(0.05);
+    trainer.setEarlyStopping(50, 1e-5);
+    trainer.setShuffle(true);
+    trainer.setSeed(7);
+}
+
+static DiwaError fit(DiwaTrainer& trainer, bool resume) {
+    return (trainer.*(resume ? &DiwaTrainer::resume : &DiwaTrainer::fit))(
+        inputs[0], outputs[0], TRAINING_SAMPLES,
+        inputs[TRAINING_SAMPLES], outputs[TRAINING_SAMPLES], VALIDATION_SAMPLES,
+        EPOCHS
+    );
+}
+
+// Saves a checkpoint every 1000 steps, and simulates a preemption
+// of the training job once PREEMPTED_STEP steps have been run
+static bool saveCheckpoint(DiwaTrainer& trainer) {
+    if(trainer.getStep() % 1000 == 0) {
+        ofstream checkpointFile("checkpoint.ann", ios::binary);
+        trainer.saveCheckpoint(checkpointFile);
+    }
+
+    return trainer.getStep() != PREEMPTED_STEP;
+}
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a circle
+    for(int i = 0; i < TRAINING_SAMPLES + VALIDATION_SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.5;
+    }
+
+    // Train a network without interruption as a reference
+    Diwa reference;
+    DiwaTrainer referenceTrainer(reference);
+
+    configure(reference, referenceTrainer);
+    fit(referenceTrainer, false);
+
+    cout << "Uninterrupted training: " << referenceTrainer.getEpoch()
+        << " epochs, " << referenceTrainer.getStep() << " steps" << endl;
+
+    // Train another network which gets preempted mid-epoch
+    {
+        Diwa network;
+        DiwaTrainer trainer(network);
+
+        configure(network, trainer);
+        trainer.setCheckpointCallback(saveCheckpoint, 50);
+
+        if(fit(trainer, false) != TRAINING_INTERRUPTED) {
+            cout << "Training was not interrupted" << endl;
+            return 1;
+        }
+
+        cout << "Preempted at step " << trainer.getStep()
+            << " (epoch " << trainer.getEpoch() << ")" << endl;
+    }
+
+    // Resume the training from the last checkpoint in a new process,
+    // i.e. with a fresh network and trainer
+    Diwa network;
+    DiwaTrainer trainer(network);
+    ifstream checkpointFile("checkpoint.ann", ios::binary);
+
+    if(trainer.loadCheckpoint(checkpointFile) != NO_ERROR) {
+        cout << "Failed to load checkpoint" << endl;
+        return 1;
+    }
+
+    cout << "Resuming from step " << trainer.getStep()
+        << " (epoch " << trainer.getEpoch() << ")" << endl;
+
+    if(fit(trainer, true) != NO_ERROR) {
+        cout << "Failed to resume training" << endl;
+        return 1;
+    }
+
+    cout << "Resumed training: " << trainer.getEpoch()
+        << " epochs, " << trainer.getStep() << " steps" << endl;
+
+    // The resumed training must end with exactly the same weights
+    double *expected = new double[reference.getWeightCount()];
+    double *actual = new double[network.getWeightCount()];
+
+    reference.getWeights(expected);
+    network.getWeights(actual);
+
+    bool identical = reference.getWeightCount() == network.getWeightCount() &&
+        memcmp(expected, actual, sizeof(double) * network.getWeightCount()) == 0;
+    cout << "Weights " << (identical ? "are" : "are NOT")
+        << " bit-identical to the uninterrupted training" << endl;
+
+    delete[] expected;
+    delete[] actual;
+
+    return identical ? 0 : 1;
+}
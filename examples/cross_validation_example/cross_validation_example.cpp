@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <diwa_validation.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES 2000
+#define FOLDS   5
+
+int main() {
+    // Points on a plane, labelled 1 when inside of a ring
+    DiwaDataset dataset;
+    if(dataset.initialize(SAMPLES, 2, 1) != NO_ERROR) {
+        cout << "Failed to allocate dataset" << endl;
+        return 1;
+    }
+
+    DiwaRandom randomizer;
+    randomizer.seed(1);
+
+    for(int i = 0; i < SAMPLES; i++) {
+        double point[2] = {
+            randomizer.nextUniform(-1, 1),
+            randomizer.nextUniform(-1, 1)
+        };
+
+        const double radius = point[0] * point[0] + point[1] * point[1];
+        double label = radius > 0.2 && radius < 0.6;
+
+        dataset.setRow(i, point, &label);
+    }
+
+    dataset.setSeed(2);
+    dataset.shuffle();
+
+    // Cross-validate a few candidate topologies, training the
+    // folds of each one concurrently
+    const int topologies[][2] = {{1, 2}, {1, 8}, {1, 24}, {2, 8}};
+
+    for(int t = 0; t < 4; t++) {
+        DiwaCrossValidation validation(FOLDS);
+        validation.setTopology(topologies[t][0], topologies[t][1]);
+        validation.setSeed(3);
+
+        steady_clock::time_point start = steady_clock::now();
+        if(validation.run(dataset, 2.0, 100, 4) != NO_ERROR) {
+            cout << "Failed to cross-validate neural network" << endl;
+            return 1;
+        }
+
+        const DiwaMetrics& metrics = validation.getMetrics();
+        cout << topologies[t][0] << " x " << setw(2) << topologies[t][1]
+            << " hidden neurons: accuracy " << fixed << setprecision(1)
+            << 100.0 * metrics.getAccuracy() << "% (+/- "
+            << 100.0 * validation.getAccuracyDeviation() << "%), MSE "
+            << setprecision(4) << metrics.getMeanSquaredError() << ", "
+            << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << " ms" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_csv.h>
+#include <diwa_dataset.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string.h>
+
+using namespace std;
+using namespace std::chrono;
+
+#define ROWS 500000
+
+int main() {
+    // Export points on a plane, labelled 1 when inside of a circle,
+    // along with an identifier and an unrelated column
+    {
+        FILE *file = fopen("dataset.csv", "w");
+        if(file == NULL) {
+            cout << "Failed to write dataset" << endl;
+            return 1;
+        }
+
+        DiwaRandom randomizer;
+        randomizer.seed(1);
+        fprintf(file, "id,x,y,noise,label\n");
+
+        for(int i = 0; i < ROWS; i++) {
+            double x = randomizer.nextUniform(-1, 1), y = randomizer.nextUniform(-1, 1);
+            fprintf(file, "%d,%.6f,%.6f,%.3e,%d\n", i, x, y,
+                randomizer.nextGaussian(0, 1), x * x + y * y < 0.5);
+        }
+
+        fclose(file);
+    }
+
+    // Parse the file with iostreams, for reference
+    static double inputs[ROWS][2], targets[ROWS][1];
+    {
+        steady_clock::time_point start = steady_clock::now();
+        ifstream file("dataset.csv");
+        string header;
+        getline(file, header);
+
+        double id, noise;
+        char comma;
+
+        for(int i = 0; i < ROWS; i++)
+            file >> id >> comma >> inputs[i][0] >> comma >> inputs[i][1]
+                >> comma >> noise >> comma >> targets[i][0];
+
+        cout << "iostream:            " << setw(5) << duration_cast<milliseconds>(
+            steady_clock::now() - start).count() << " ms" << endl;
+    }
+
+    // Parse the x and y columns as inputs and the label column as target,
+    // with a single thread and with one thread per hardware thread
+    const int inputColumns[] = {1, 2}, targetColumns[] = {4};
+    DiwaDataset dataset;
+
+    for(int threads = 1; threads >= 0; threads--) {
+        DiwaCsvReader reader;
+        reader.setThreads(threads);
+        reader.setInputColumns(inputColumns, 2);
+        reader.setTargetColumns(targetColumns, 1);
+
+        steady_clock::time_point start = steady_clock::now();
+        if(reader.read("dataset.csv", dataset) != NO_ERROR) {
+            cout << "Failed to read dataset (row " << reader.getErrorRow() << ")" << endl;
+            return 1;
+        }
+
+        cout << "DiwaCsvReader (" << (threads ? "1 thread" : "all threads") << "): "
+            << setw(4) << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << " ms" << endl;
+    }
+
+    bool identical = dataset.getSampleCount() == ROWS &&
+        memcmp(dataset.getInputs(), inputs, sizeof(inputs)) == 0 &&
+        memcmp(dataset.getTargets(), targets, sizeof(targets)) == 0;
+    cout << dataset.getSampleCount() << " samples, "
+        << (identical ? "identical to" : "DIFFERENT from") << " iostream parsing" << endl;
+
+    // Train on the dataset straight from its contiguous storage
+    Diwa network;
+    network.setSeed(1);
+
+    if(network.initialize(2, 1, 16, 1) != NO_ERROR ||
+        network.fit(0.5, dataset, 1, 1) != NO_ERROR) {
+        cout << "Failed to train neural network" << endl;
+        return 1;
+    }
+
+    int correct = 0;
+    for(int i = 0; i < 10000; i++)
+        if((network.inference(inputs[i])[0] >= 0.5) == (targets[i][0] == 1))
+            correct++;
+
+    cout << "Accuracy after one epoch: " << fixed << setprecision(1)
+        << (correct / 100.0) << "%" << endl;
+
+    remove("dataset.csv");
+    return identical ? 0 : 1;
+}
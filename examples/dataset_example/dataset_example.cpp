@@ -0,0 +1,110 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <diwa_metrics.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES 1200
+#define EPOCHS  100
+
+// Evaluates the network over a whole dataset, on every hardware thread
+static double accuracy(Diwa& network, DiwaDataset& dataset) {
+    DiwaMetrics metrics;
+
+    if(network.evaluate(dataset, metrics) != NO_ERROR)
+        return 0;
+    return 100.0 * metrics.getAccuracy();
+}
+
+int main() {
+    // Store points on a plane, labelled 1 when inside of a circle,
+    // directly into the storage of the dataset
+    DiwaDataset dataset;
+    if(dataset.initialize(SAMPLES, 2, 1) != NO_ERROR) {
+        cout << "Failed to allocate dataset" << endl;
+        return 1;
+    }
+
+    DiwaRandom randomizer;
+    randomizer.seed(1);
+
+    for(int i = 0; i < SAMPLES; i++) {
+        double point[2] = {
+            randomizer.nextUniform(-1, 1),
+            randomizer.nextUniform(-1, 1)
+        };
+        double label = point[0] * point[0] + point[1] * point[1] < 0.5;
+
+        dataset.setRow(i, point, &label);
+    }
+
+    // Shuffle the samples, then keep a quarter of them for validation;
+    // neither operation moves the samples in memory
+    DiwaDataset training, validation;
+    dataset.setSeed(2);
+    dataset.shuffle();
+
+    if(dataset.split(0.25, training, validation) != NO_ERROR) {
+        cout << "Failed to split dataset" << endl;
+        return 1;
+    }
+
+    cout << training.getSampleCount() << " training samples, "
+        << validation.getSampleCount() << " validation samples" << endl << endl;
+
+    const int batchSizes[] = {1, 8, 32};
+    const double learningRates[] = {0.5, 2.0, 4.0};
+
+    for(int i = 0; i < 3; i++) {
+        Diwa network;
+        network.setSeed(1);
+
+        if(network.initialize(2, 1, 16, 1) != NO_ERROR) {
+            cout << "Failed to initialize neural network" << endl;
+            return 1;
+        }
+
+        // Train the neural network over the training view of the dataset
+        steady_clock::time_point start = steady_clock::now();
+        training.setSeed(3);
+
+        if(network.fit(learningRates[i], training, EPOCHS, batchSizes[i]) != NO_ERROR) {
+            cout << "Failed to train neural network" << endl;
+            return 1;
+        }
+
+        cout << "Batch size " << setw(2) << batchSizes[i] << ": "
+            << setw(4) << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << " ms, training accuracy " << fixed << setprecision(1)
+            << accuracy(network, training) << "%, validation accuracy "
+            << accuracy(network, validation) << "%" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_evolution.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+int main() {
+    // Create an instance of the Diwa neural network
+    Diwa network;
+
+    // Define input-output pairs for training the neural network
+    double trainingInput[4][2] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    double trainingOutput[4][1] = {{1}, {0}, {0}, {1}};
+
+    // Initialize the neural network using the clamped gaussian activation
+    network.setSeed(5);
+    if(network.initialize(2, 1, 4, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+    network.setActivationFunction(DiwaActivationFunc::gaussian);
+
+    // Evolve the weights with 64 candidates per generation, scored
+    // in parallel using every hardware thread
+    DiwaEvolution evolution(network, 64);
+    evolution.setSeed(9);
+    evolution.setNoise(0.1);
+    evolution.setLearningRate(0.1);
+
+    cout << "Starting neural network evolution... " << endl;
+    if(evolution.evolve(trainingInput[0], trainingOutput[0], 4, 2000, 0.001) != NO_ERROR) {
+        cout << "Failed to evolve neural network" << endl;
+        exit(0);
+    }
+
+    cout << "Evolution done after " << evolution.getGenerations()
+        << " generations (loss: " << evolution.getLoss() << ")" << endl << endl;
+
+    // Perform inference for each input and print the output
+    cout << "Testing neural network inferences..." << endl;
+    for(uint8_t i = 0; i < 4; i++) {
+        double* row = trainingInput[i];
+        double* inferred = network.inference(row);
+
+        cout << "\t[" << fixed << setprecision(1) << row[0] << ", "
+              << fixed << setprecision(1) << row[1] << "]: "
+              << (inferred[0] >= 0.5) << " ("
+              << fixed << setprecision(6) << inferred[0] << ")" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_fixed.h>
+#include <math.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+#define SAMPLES         400
+#define EPOCHS          300
+#define LEARNING_RATE   0.5
+
+static double inputs[SAMPLES][2];
+static double outputs[SAMPLES][1];
+
+static diwa_fixed fixedInputs[SAMPLES][2];
+static diwa_fixed fixedOutputs[SAMPLES][1];
+
+// Trains a fixed-point copy of the network and reports its accuracy,
+// then exports it back and measures how far the double inference drifts
+static void trainFixed(const char *name, Diwa& initial, bool stochastic) {
+    DiwaFixed network;
+    network.setSeed(1);
+    network.setStochasticRounding(stochastic);
+
+    if(network.importNetwork(initial) != NO_ERROR) {
+        cout << "Failed to import neural network" << endl;
+        exit(0);
+    }
+
+    const diwa_fixed learningRate = DiwaFixed::toFixed(LEARNING_RATE);
+    double loss = 0;
+
+    for(int epoch = 0; epoch < EPOCHS; epoch++) {
+        loss = 0;
+
+        for(int i = 0; i < SAMPLES; i++)
+            loss += DiwaFixed::toDouble(network.train(learningRate, fixedInputs[i], fixedOutputs[i]));
+        loss /= SAMPLES;
+    }
+
+    Diwa exported;
+    if(network.exportNetwork(exported) != NO_ERROR) {
+        cout << "Failed to export neural network" << endl;
+        exit(0);
+    }
+
+    int correct = 0;
+    double drift = 0;
+
+    for(int i = 0; i < SAMPLES; i++) {
+        const double output = DiwaFixed::toDouble(network.inference(fixedInputs[i])[0]);
+        if((output >= 0.5) == (outputs[i][0] >= 0.5))
+            correct++;
+
+        drift = fmax(drift, fabs(exported.inference(inputs[i])[0] - output));
+    }
+
+    cout << name << "\tLoss: " << fixed << setprecision(4) << loss
+        << "\t| Accuracy: " << setprecision(1) << correct * 100.0 / SAMPLES << "%"
+        << "\t| Export drift: " << setprecision(4) << drift << endl;
+}
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a circle
+    for(int i = 0; i < SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.5;
+
+        fixedInputs[i][0] = DiwaFixed::toFixed(inputs[i][0]);
+        fixedInputs[i][1] = DiwaFixed::toFixed(inputs[i][1]);
+        fixedOutputs[i][0] = DiwaFixed::toFixed(outputs[i][0]);
+    }
+
+    cout << "Format: Q" << 32 - DIWA_FIXED_FRACTION_BITS << "."
+        << DIWA_FIXED_FRACTION_BITS << endl << endl;
+
+    Diwa initial;
+    initial.setSeed(1);
+    if(initial.initialize(2, 1, 8, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    // Train the double network from the same initial weights as reference
+    {
+        Diwa network;
+        network.setSeed(1);
+        network.initialize(2, 1, 8, 1);
+
+        double loss = 0;
+        for(int epoch = 0; epoch < EPOCHS; epoch++) {
+            loss = 0;
+
+            for(int i = 0; i < SAMPLES; i++)
+                loss += network.train(LEARNING_RATE, inputs[i], outputs[i]);
+            loss /= SAMPLES;
+        }
+
+        int correct = 0;
+        for(int i = 0; i < SAMPLES; i++)
+            if((network.inference(inputs[i])[0] >= 0.5) == (outputs[i][0] >= 0.5))
+                correct++;
+
+        cout << "Double:\t\tLoss: " << fixed << setprecision(4) << loss
+            << "\t| Accuracy: " << setprecision(1) << correct * 100.0 / SAMPLES << "%" << endl;
+    }
+
+    // Rounding to the nearest loses the updates smaller than the resolution of the
+    // format, build with -DDIWA_FIXED_FRACTION_BITS=8 to see the difference it makes
+    trainFixed("Stochastic:", initial, true);
+    trainFixed("Nearest:", initial, false);
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_evolution.h>
+#include <diwa_lbfgs.h>
+#include <iostream>
+#include <string.h>
+
+using namespace std;
+
+#define MAX_WEIGHTS 64
+
+// Compares the weights of the network against a snapshot, returning false
+// if a frozen weight moved or if no trainable weight did
+static bool check(Diwa& network, const double *snapshot, int frozen, const char *trainer) {
+    static double weights[MAX_WEIGHTS];
+    network.getWeights(weights);
+
+    const bool kept = memcmp(weights, snapshot, sizeof(double) * frozen) == 0;
+    const bool trained = memcmp(
+        weights + frozen, snapshot + frozen,
+        sizeof(double) * (network.getWeightCount() - frozen)
+    ) != 0;
+
+    cout << trainer << ": frozen weights " << (kept ? "unchanged" : "CHANGED")
+        << ", trainable weights " << (trained ? "updated" : "NOT UPDATED") << endl;
+    return kept && trained;
+}
+
+int main() {
+    // Create an instance of the Diwa neural network
+    Diwa network;
+
+    // Define input-output pairs for training the neural network
+    double trainingInput[4][2] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    double trainingOutput[4][1] = {{0}, {1}, {1}, {0}};
+
+    // Initialize a network with two hidden layers of 4 neurons
+    network.setSeed(3);
+    if(network.initialize(2, 2, 4, 1) != NO_ERROR ||
+        network.getWeightCount() > MAX_WEIGHTS) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    // Freeze the first hidden layer, whose (2 + 1) * 4 weights come first
+    const int frozen = (2 + 1) * 4;
+    network.setLayerTrainable(0, false);
+
+    static double snapshot[MAX_WEIGHTS];
+    network.getWeights(snapshot);
+
+    // Every trainer must leave the frozen weights bit-identical
+    bool passed = true;
+    for(int epoch = 0; epoch < 100; epoch++)
+        for(int i = 0; i < 4; i++)
+            network.train(0.5, trainingInput[i], trainingOutput[i]);
+    passed &= check(network, snapshot, frozen, "train()");
+
+    DiwaEvolution evolution(network, 16);
+    evolution.setSeed(7);
+    evolution.evolve(trainingInput[0], trainingOutput[0], 4, 50, 0);
+    passed &= check(network, snapshot, frozen, "DiwaEvolution::evolve()");
+
+    DiwaLBFGS lbfgs(network);
+    lbfgs.minimize(trainingInput[0], trainingOutput[0], 4, 50, 0);
+    passed &= check(network, snapshot, frozen, "DiwaLBFGS::minimize()");
+
+    return passed ? 0 : 1;
+}
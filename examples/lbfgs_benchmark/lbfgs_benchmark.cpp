@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_lbfgs.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES     400
+#define TARGET_LOSS 0.02
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a circle
+    static double inputs[SAMPLES][2];
+    static double outputs[SAMPLES][1];
+
+    for(int i = 0; i < SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.5;
+    }
+
+    cout << "Target loss: " << TARGET_LOSS << endl << endl;
+
+    // Train with stochastic gradient descent, one epoch at a time,
+    // until the full-batch loss reaches the target loss
+    {
+        Diwa network;
+        network.setSeed(1);
+        if(network.initialize(2, 1, 8, 1) != NO_ERROR) {
+            cout << "Failed to initialize neural network" << endl;
+            exit(0);
+        }
+
+        double *gradient = new double[network.getWeightCount()];
+        double loss = network.calculateGradient(inputs[0], outputs[0], SAMPLES, gradient);
+
+        int epoch = 0;
+        steady_clock::time_point start = steady_clock::now();
+
+        while(loss > TARGET_LOSS && epoch < 5000) {
+            for(int i = 0; i < SAMPLES; i++)
+                network.train(1.0, inputs[i], outputs[i]);
+
+            loss = network.calculateGradient(inputs[0], outputs[0], SAMPLES, gradient);
+            epoch++;
+        }
+
+        double elapsed = duration<double, milli>(steady_clock::now() - start).count();
+        delete[] gradient;
+
+        cout << "SGD:\t" << epoch << " epochs\t| Loss: " << loss
+            << "\t| Time: " << fixed << setprecision(2) << elapsed << " ms" << endl;
+        cout.unsetf(ios::fixed);
+    }
+
+    // Train with L-BFGS on the same initial weights
+    {
+        Diwa network;
+        network.setSeed(1);
+        if(network.initialize(2, 1, 8, 1) != NO_ERROR) {
+            cout << "Failed to initialize neural network" << endl;
+            exit(0);
+        }
+
+        DiwaLBFGS optimizer(network);
+        steady_clock::time_point start = steady_clock::now();
+
+        if(optimizer.minimize(inputs[0], outputs[0], SAMPLES, 20000, TARGET_LOSS) != NO_ERROR) {
+            cout << "Failed to train neural network" << endl;
+            exit(0);
+        }
+
+        double elapsed = duration<double, milli>(steady_clock::now() - start).count();
+        cout << "L-BFGS:\t" << optimizer.getEvaluations() << " passes\t| Loss: " << optimizer.getLoss()
+            << "\t| Time: " << fixed << setprecision(2) << elapsed << " ms" << endl;
+    }
+
+    return 0;
+}
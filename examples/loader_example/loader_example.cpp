@@ -0,0 +1,154 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <diwa_loader.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <string.h>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES     20000
+#define EPOCHS      5
+
+// Converts raw 12-bit sensor readings into calibrated values within [-1, 1]
+static void calibrate(double *inputs, int inputCount, double *targets, int targetCount) {
+    (void) targets;
+    (void) targetCount;
+
+    for(int i = 0; i < inputCount; i++) {
+        double reading = inputs[i] / 4095.0;
+
+        for(int j = 0; j < 8; j++)
+            reading = reading - 0.01 * sin(2 * M_PI * reading) / (2 * M_PI);
+        inputs[i] = 2 * reading - 1;
+    }
+}
+
+// Counts the correct inferences of the network over the dataset
+static double accuracy(Diwa& network, DiwaDataset& dataset) {
+    int correct = 0;
+
+    for(int i = 0; i < dataset.getSampleCount(); i++) {
+        double inputs[2], targets[1];
+
+        memcpy(inputs, dataset.getSampleInputs(i), sizeof(inputs));
+        memcpy(targets, dataset.getSampleTargets(i), sizeof(targets));
+        calibrate(inputs, 2, targets, 1);
+
+        if((network.inference(inputs)[0] >= 0.5) == (targets[0] == 1))
+            correct++;
+    }
+
+    return 100.0 * correct / dataset.getSampleCount();
+}
+
+int main() {
+    // Store raw sensor readings, labelled 1 when the calibrated
+    // point lies inside of a circle
+    DiwaDataset dataset;
+    if(dataset.initialize(SAMPLES, 2, 1) != NO_ERROR) {
+        cout << "Failed to allocate dataset" << endl;
+        return 1;
+    }
+
+    DiwaRandom randomizer;
+    randomizer.seed(1);
+
+    for(int i = 0; i < SAMPLES; i++) {
+        double raw[2] = {
+            floor(randomizer.nextUniform(0, 4096)),
+            floor(randomizer.nextUniform(0, 4096))
+        };
+        double point[2], label[1];
+
+        memcpy(point, raw, sizeof(point));
+        calibrate(point, 2, label, 1);
+        label[0] = point[0] * point[0] + point[1] * point[1] < 0.5;
+
+        dataset.setRow(i, raw, label);
+    }
+
+    // Prepare every sample on the training thread
+    {
+        Diwa network;
+        network.setSeed(1);
+        network.initialize(2, 1, 32, 1);
+
+        steady_clock::time_point start = steady_clock::now();
+        dataset.setSeed(2);
+
+        for(int epoch = 0; epoch < EPOCHS; epoch++) {
+            dataset.shuffle();
+
+            for(int i = 0; i < SAMPLES; i++) {
+                double inputs[2], targets[1];
+
+                memcpy(inputs, dataset.getSampleInputs(i), sizeof(inputs));
+                memcpy(targets, dataset.getSampleTargets(i), sizeof(targets));
+                calibrate(inputs, 2, targets, 1);
+
+                network.train(0.5, inputs, targets);
+            }
+        }
+
+        cout << "Inline preparation: " << setw(4) << duration_cast<milliseconds>(
+            steady_clock::now() - start).count() << " ms, accuracy "
+            << fixed << setprecision(1) << accuracy(network, dataset) << "%" << endl;
+    }
+
+    // Prepare the batches on the loader thread, up to three batches ahead;
+    // on machines with more than one core, preparation overlaps training
+    {
+        Diwa network;
+        network.setSeed(1);
+        network.initialize(2, 1, 32, 1);
+
+        steady_clock::time_point start = steady_clock::now();
+        DiwaLoader loader(dataset);
+
+        dataset.setSeed(2);
+        loader.setTransform(calibrate);
+
+        if(loader.start(64, 4, EPOCHS) != NO_ERROR) {
+            cout << "Failed to start loader" << endl;
+            return 1;
+        }
+
+        while(loader.train(network, 0.5) >= 0)
+            ;
+
+        cout << "Loader thread:      " << setw(4) << duration_cast<milliseconds>(
+            steady_clock::now() - start).count() << " ms, accuracy "
+            << accuracy(network, dataset) << "%" << endl;
+        cout << "Loader busy for " << setprecision(0) << loader.getLoadTime() * 1000
+            << " ms, training stalled for " << setprecision(1)
+            << loader.getStallTime() * 1000 << " ms" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_mapped.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES     500000
+#define CHUNK       10000
+#define EPOCHS      3
+
+int main() {
+#if defined(__unix__) || defined(__APPLE__)
+    // Write the dataset file chunk by chunk, so that the whole
+    // dataset never has to be held in memory
+    {
+        ofstream file("dataset.diwd", ios::binary);
+        DiwaMappedDataset::writeHeader(file, SAMPLES, 2, 1);
+
+        static double inputs[CHUNK][2], targets[CHUNK][1];
+        DiwaRandom randomizer;
+        randomizer.seed(1);
+
+        for(int written = 0; written < SAMPLES; written += CHUNK) {
+            for(int i = 0; i < CHUNK; i++) {
+                inputs[i][0] = randomizer.nextUniform(-1, 1);
+                inputs[i][1] = randomizer.nextUniform(-1, 1);
+                targets[i][0] = inputs[i][0] * inputs[i][0] +
+                    inputs[i][1] * inputs[i][1] < 0.5;
+            }
+
+            if(DiwaMappedDataset::writeSamples(file, inputs[0], targets[0], CHUNK, 2, 1) != NO_ERROR) {
+                cout << "Failed to write dataset" << endl;
+                return 1;
+            }
+        }
+    }
+
+    // Map the dataset file into memory
+    DiwaMappedDataset dataset;
+    dataset.setSeed(2);
+
+    if(dataset.open("dataset.diwd") != NO_ERROR) {
+        cout << "Failed to open dataset" << endl;
+        return 1;
+    }
+
+    cout << dataset.getSampleCount() << " samples, "
+        << dataset.getBlockSize() << " samples per block" << endl;
+
+    Diwa network;
+    network.setSeed(1);
+
+    if(network.initialize(2, 1, 16, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        return 1;
+    }
+
+    // Stream over the dataset, one shuffled block at a time
+    for(int epoch = 0; epoch < EPOCHS; epoch++) {
+        steady_clock::time_point start = steady_clock::now();
+        double loss = dataset.train(network, 0.5);
+
+        cout << "Epoch " << (epoch + 1) << ": loss " << fixed << setprecision(5)
+            << loss << ", " << duration_cast<milliseconds>(
+                steady_clock::now() - start).count() << " ms" << endl;
+    }
+
+    // Check the accuracy on the first samples of the file
+    int correct = 0;
+    for(int i = 0; i < 10000; i++)
+        if((network.inference((double*) dataset.getInputs(i))[0] >= 0.5) ==
+            (dataset.getTargets(i)[0] == 1))
+            correct++;
+
+    cout << "Accuracy: " << setprecision(1) << (correct / 100.0) << "%" << endl;
+
+    dataset.close();
+    remove("dataset.diwd");
+#else
+    cout << "Memory-mapped datasets are not supported on this platform" << endl;
+#endif
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+// Trains the same network in double and in mixed precision from the same
+// initial weights, then reports the final loss, accuracy and training time
+static void compare(
+    const char *name,
+    double *inputs, int inputCount,
+    double *outputs, int outputCount,
+    int samples, int hiddenLayers, int hiddenNeurons,
+    DiwaOutputMode mode, double learningRate, int epochs
+) {
+    cout << name << endl;
+
+    for(int mixed = 0; mixed < 2; mixed++) {
+        Diwa network;
+        network.setSeed(1);
+
+        if(network.initialize(inputCount, hiddenLayers, hiddenNeurons, outputCount) != NO_ERROR) {
+            cout << "Failed to initialize neural network" << endl;
+            exit(0);
+        }
+
+        network.setOutputMode(mode);
+        network.setMixedPrecision(mixed);
+
+        double loss = 0;
+        steady_clock::time_point start = steady_clock::now();
+
+        for(int epoch = 0; epoch < epochs; epoch++) {
+            loss = 0;
+
+            for(int i = 0; i < samples; i++)
+                loss += network.train(
+                    learningRate,
+                    inputs + i * inputCount,
+                    outputs + i * outputCount
+                );
+            loss /= samples;
+        }
+
+        double elapsed = duration<double, milli>(steady_clock::now() - start).count();
+
+        int correct = 0;
+        for(int i = 0; i < samples; i++) {
+            double *target = outputs + i * outputCount;
+
+            if(mode == SOFTMAX_OUTPUT) {
+                if(target[network.classify(inputs + i * inputCount)] == 1)
+                    correct++;
+            }
+            else if((network.inference(inputs + i * inputCount)[0] >= 0.5) == (target[0] >= 0.5))
+                correct++;
+        }
+
+        cout << (mixed ? "\tMixed:\t" : "\tDouble:\t") << "Loss: " << fixed << setprecision(6) << loss
+            << "\t| Accuracy: " << setprecision(1) << correct * 100.0 / samples << "%"
+            << "\t| Time: " << setprecision(2) << elapsed << " ms" << endl;
+        cout.unsetf(ios::fixed);
+    }
+}
+
+int main() {
+    // The XOR dataset of the basic example
+    double xorInputs[4][2] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    double xorOutputs[4][1] = {{1}, {0}, {0}, {1}};
+
+    compare(
+        "XOR (2-3-1):", xorInputs[0], 2, xorOutputs[0], 1,
+        4, 1, 3, ACTIVATION_OUTPUT, 6, 3000
+    );
+
+    // Points on a plane, labelled 1 when inside of a circle
+    static double circleInputs[2000][2];
+    static double circleOutputs[2000][1];
+
+    for(int i = 0; i < 2000; i++) {
+        circleInputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        circleInputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        circleOutputs[i][0] = (circleInputs[i][0] * circleInputs[i][0] +
+            circleInputs[i][1] * circleInputs[i][1]) < 0.5;
+    }
+
+    compare(
+        "Circle (2-32-32-1):", circleInputs[0], 2, circleOutputs[0], 1,
+        2000, 2, 32, ACTIVATION_OUTPUT, 0.5, 100
+    );
+
+    // Sixteen noisy features, classified by which quarter holds the largest sum
+    static double clusterInputs[2000][16];
+    static double clusterOutputs[2000][4];
+
+    for(int i = 0; i < 2000; i++) {
+        double sums[4] = {0, 0, 0, 0};
+
+        for(int j = 0; j < 16; j++) {
+            clusterInputs[i][j] = (double) rand() / RAND_MAX;
+            sums[j / 4] += clusterInputs[i][j];
+        }
+
+        int label = 0;
+        for(int j = 1; j < 4; j++)
+            if(sums[j] > sums[label])
+                label = j;
+
+        for(int j = 0; j < 4; j++)
+            clusterOutputs[i][j] = j == label;
+    }
+
+    compare(
+        "Quarters (16-64-4, softmax):", clusterInputs[0], 16, clusterOutputs[0], 4,
+        2000, 1, 64, SOFTMAX_OUTPUT, 0.05, 50
+    );
+
+    return 0;
+}
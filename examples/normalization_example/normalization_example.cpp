@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+
+using namespace std;
+
+#define SAMPLES 2000
+
+int main() {
+    // Simulated 12-bit ADC readings of two sensors, labelled 1 when
+    // the first sensor reads higher than the second one
+    static uint16_t readings[SAMPLES][2];
+    static double inputs[SAMPLES][2], targets[SAMPLES][1];
+
+    DiwaRandom randomizer;
+    randomizer.seed(1);
+
+    for(int i = 0; i < SAMPLES; i++) {
+        readings[i][0] = (uint16_t) randomizer.nextUniform(1000, 3000);
+        readings[i][1] = (uint16_t) randomizer.nextUniform(1500, 2500);
+        targets[i][0] = readings[i][0] > readings[i][1];
+    }
+
+    // Standardize the readings for training
+    double means[2] = {0, 0}, deviations[2] = {0, 0};
+    for(int i = 0; i < SAMPLES; i++)
+        for(int j = 0; j < 2; j++)
+            means[j] += readings[i][j] / (double) SAMPLES;
+
+    for(int i = 0; i < SAMPLES; i++)
+        for(int j = 0; j < 2; j++)
+            deviations[j] += (readings[i][j] - means[j]) *
+                (readings[i][j] - means[j]) / SAMPLES;
+
+    for(int j = 0; j < 2; j++) {
+        deviations[j] = sqrt(deviations[j]);
+
+        for(int i = 0; i < SAMPLES; i++)
+            inputs[i][j] = (readings[i][j] - means[j]) / deviations[j];
+    }
+
+    DiwaDataset dataset;
+    Diwa network;
+    network.setSeed(1);
+
+    if(dataset.initialize(inputs[0], targets[0], SAMPLES, 2, 1) != NO_ERROR ||
+        network.initialize(2, 1, 8, 1) != NO_ERROR ||
+        network.fit(0.5, dataset, 20, 1) != NO_ERROR) {
+        cout << "Failed to train neural network" << endl;
+        return 1;
+    }
+
+    double before = network.inference(inputs[0])[0];
+
+    // Fold the standardization into the first layer, then serve raw readings
+    if(network.setInputNormalization(means, deviations) != NO_ERROR) {
+        cout << "Failed to set input normalization" << endl;
+        return 1;
+    }
+
+    double after = network.inference(readings[0])[0];
+    cout << "Output on standardized inputs: " << setprecision(10) << before << endl
+        << "Output on raw readings:        " << after << endl;
+
+    int correct = 0;
+    for(int i = 0; i < SAMPLES; i++)
+        if((network.inference(readings[i])[0] >= 0.5) == (targets[i][0] == 1))
+            correct++;
+
+    cout << "Accuracy on raw readings: " << fixed << setprecision(1)
+        << (100.0 * correct / SAMPLES) << "%" << endl;
+
+    return fabs(before - after) < 1e-9 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <diwa_npy.h>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+#define SAMPLES 100000
+
+int main() {
+#if defined(__unix__) || defined(__APPLE__)
+    // Export points on a plane and whether they are inside of a circle, as
+    // a feature pipeline would with numpy.save()
+    {
+        DiwaNpy inputs, targets;
+        DiwaRandom randomizer;
+        randomizer.seed(1);
+
+        if(inputs.create("inputs.npy", SAMPLES, 2) != NO_ERROR ||
+            targets.create("targets.npy", SAMPLES, 1, true) != NO_ERROR) {
+            cout << "Failed to create arrays" << endl;
+            return 1;
+        }
+
+        for(int i = 0; i < SAMPLES; i++) {
+            double point[2] = {randomizer.nextUniform(-1, 1), randomizer.nextUniform(-1, 1)};
+            double label = point[0] * point[0] + point[1] * point[1] < 0.5;
+
+            inputs.setRow(i, point);
+            targets.setRow(i, &label);
+        }
+    }
+
+    // Map the arrays back; the float64 inputs are used in place
+    DiwaNpy inputs, targets;
+    if(inputs.open("inputs.npy") != NO_ERROR || targets.open("targets.npy") != NO_ERROR) {
+        cout << "Failed to open arrays" << endl;
+        return 1;
+    }
+
+    cout << "inputs.npy:  " << inputs.getRows() << "x" << inputs.getColumns()
+        << (inputs.isSinglePrecision() ? " float32" : " float64") << endl;
+    cout << "targets.npy: " << targets.getRows() << "x" << targets.getColumns()
+        << (targets.isSinglePrecision() ? " float32" : " float64") << endl;
+
+    DiwaDataset dataset;
+    Diwa network;
+    network.setSeed(1);
+
+    if(dataset.initialize(inputs, targets) != NO_ERROR ||
+        network.initialize(2, 1, 16, 1) != NO_ERROR ||
+        network.fit(0.5, dataset, 3, 1) != NO_ERROR) {
+        cout << "Failed to train neural network" << endl;
+        return 1;
+    }
+
+    // Infer every row of the mapped inputs straight into a new array
+    DiwaNpy outputs;
+    if(outputs.create("outputs.npy", SAMPLES, 1, true) != NO_ERROR ||
+        inputs.inference(network, outputs) != NO_ERROR) {
+        cout << "Failed to run batch inference" << endl;
+        return 1;
+    }
+
+    int correct = 0;
+    for(int i = 0; i < SAMPLES; i++)
+        if((outputs.getFloats()[i] >= 0.5) == (targets.getFloats()[i] == 1))
+            correct++;
+
+    cout << "Accuracy: " << fixed << setprecision(1)
+        << (100.0 * correct / SAMPLES) << "%" << endl;
+
+    outputs.close();
+    inputs.close();
+    targets.close();
+
+    remove("inputs.npy");
+    remove("targets.npy");
+    remove("outputs.npy");
+#else
+    cout << "NumPy arrays are not supported on this platform" << endl;
+#endif
+
+    return 0;
+}
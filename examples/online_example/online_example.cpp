@@ -0,0 +1,118 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_online.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+
+#define CLIENTS     4
+#define WINDOWS     8
+#define WINDOW_MS   250
+
+static atomic<int> correct[WINDOWS], served[WINDOWS];
+static atomic<long> slowest;
+
+// Simulates a client that asks the network whether a point is inside of a circle,
+// then reports the true answer as feedback so that the network learns from it
+static void client(DiwaOnline& online, int id, steady_clock::time_point begin) {
+    DiwaRandom randomizer;
+    randomizer.seed(id);
+
+    double outputs[64], inputs[2], target[1];
+    for(;;) {
+        const int window = (int) (duration_cast<milliseconds>(
+            steady_clock::now() - begin).count() / WINDOW_MS);
+        if(window >= WINDOWS)
+            break;
+
+        inputs[0] = randomizer.nextUniform(-1, 1);
+        inputs[1] = randomizer.nextUniform(-1, 1);
+        target[0] = inputs[0] * inputs[0] + inputs[1] * inputs[1] < 0.5;
+
+        steady_clock::time_point start = steady_clock::now();
+        const bool inside = online.inference(inputs, outputs)[0] >= 0.5;
+        const long latency = (long) duration_cast<nanoseconds>(
+            steady_clock::now() - start).count();
+
+        for(long seen = slowest; latency > seen &&
+            !slowest.compare_exchange_weak(seen, latency);)
+            ;
+
+        served[window]++;
+        if(inside == (target[0] == 1))
+            correct[window]++;
+
+        online.push(inputs, target);
+        this_thread::sleep_for(microseconds(50));
+    }
+}
+
+int main() {
+    // Create an untrained neural network
+    Diwa network;
+    network.setSeed(1);
+
+    if(network.initialize(2, 1, 16, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        return 1;
+    }
+
+    // Serve inferences while training in the background on the feedback
+    DiwaOnline online(network);
+    if(online.initialize(1024) != NO_ERROR ||
+        online.start(1.0, 32) != NO_ERROR) {
+        cout << "Failed to start online learning" << endl;
+        return 1;
+    }
+
+    steady_clock::time_point begin = steady_clock::now();
+    thread clients[CLIENTS];
+
+    for(int i = 0; i < CLIENTS; i++)
+        clients[i] = thread(client, ref(online), i + 1, begin);
+    for(int i = 0; i < CLIENTS; i++)
+        clients[i].join();
+
+    online.stop();
+
+    int total = 0;
+    for(int i = 0; i < WINDOWS; i++) {
+        cout << setw(5) << (i + 1) * WINDOW_MS << " ms: " << setw(6) << served[i]
+            << " inferences, accuracy " << fixed << setprecision(1)
+            << (served[i] ? 100.0 * correct[i] / served[i] : 0.0) << "%" << endl;
+        total += served[i];
+    }
+
+    cout << endl << total << " inferences served, " << online.getTrained()
+        << " samples trained on, " << online.getDropped() << " dropped, "
+        << online.getVersion() << " weight snapshots published" << endl;
+    cout << "Slowest inference: " << slowest / 1000.0 << " us" << endl;
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_quantized.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+#define SAMPLES     1000
+#define EPOCHS      400
+
+static double inputs[SAMPLES][2];
+static double outputs[SAMPLES][1];
+
+static double accuracyOf(Diwa& network) {
+    int correct = 0;
+
+    for(int i = 0; i < SAMPLES; i++)
+        if((network.inference(inputs[i])[0] >= 0.5) == (outputs[i][0] >= 0.5))
+            correct++;
+
+    return (double) correct / SAMPLES;
+}
+
+static void train(Diwa& network, int epochs, double learningRate) {
+    for(int epoch = 0; epoch < epochs; epoch++)
+        for(int i = 0; i < SAMPLES; i++)
+            network.train(learningRate, inputs[i], outputs[i]);
+}
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a ring
+    for(int i = 0; i < SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        double radius = inputs[i][0] * inputs[i][0] + inputs[i][1] * inputs[i][1];
+        outputs[i][0] = radius > 0.2 && radius < 0.6;
+    }
+
+    // Train a small network in double precision
+    Diwa network;
+    network.setSeed(1);
+
+    if(network.initialize(2, 1, 12, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    train(network, EPOCHS, 0.5);
+
+    double *trained = new double[network.getWeightCount()];
+    network.getWeights(trained);
+
+    // Fine-tune it as usual, then quantize it after training
+    train(network, EPOCHS / 4, 0.2);
+    double fineTunedAccuracy = accuracyOf(network);
+
+    DiwaQuantized quantized;
+    if(quantized.quantize(network) != NO_ERROR) {
+        cout << "Failed to quantize neural network" << endl;
+        exit(0);
+    }
+    double postTrainingAccuracy = quantized.calculateAccuracy(inputs[0], outputs[0], SAMPLES);
+
+    // Fine-tune it from the same weights with fake-quantized weights instead
+    network.setWeights(trained);
+    network.setQuantizationAware(true);
+    train(network, EPOCHS / 4, 0.2);
+    delete[] trained;
+
+    if(quantized.quantize(network) != NO_ERROR) {
+        cout << "Failed to quantize neural network" << endl;
+        exit(0);
+    }
+    double quantizationAwareAccuracy = quantized.calculateAccuracy(inputs[0], outputs[0], SAMPLES);
+
+    // Save the quantized model and load it back
+    ofstream outputFile("model.diwq", ios::binary);
+    if(quantized.saveToFile(outputFile) != NO_ERROR) {
+        cout << "Failed to save quantized model" << endl;
+        exit(0);
+    }
+    outputFile.close();
+
+    DiwaQuantized loaded;
+    ifstream inputFile("model.diwq", ios::binary);
+
+    if(loaded.loadFromFile(inputFile) != NO_ERROR) {
+        cout << "Failed to load quantized model" << endl;
+        exit(0);
+    }
+    inputFile.close();
+
+    cout << fixed << setprecision(1);
+    cout << "Double precision:\t\t" << fineTunedAccuracy * 100 << "%\t("
+        << network.getWeightCount() * 8 << " bytes of weights)" << endl;
+    cout << "Post-training int8:\t\t" << postTrainingAccuracy * 100 << "%" << endl;
+    cout << "Quantization-aware int8:\t" << quantizationAwareAccuracy * 100 << "%\t("
+        << quantized.getModelSize() << " bytes of model file)" << endl;
+    cout << "Loaded int8 model:\t\t"
+        << loaded.calculateAccuracy(inputs[0], outputs[0], SAMPLES) * 100 << "%" << endl;
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_sampler.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES         2000
+#define TARGET_ACCURACY 0.98
+#define MAX_PASSES      300
+
+static double accuracyOf(Diwa& network, double *inputs, double *outputs) {
+    int correct = 0;
+
+    for(int i = 0; i < SAMPLES; i++)
+        if((network.inference(inputs + i * 2)[0] >= 0.5) == (outputs[i] >= 0.5))
+            correct++;
+
+    return (double) correct / SAMPLES;
+}
+
+static void benchmark(const char *name, double alpha, double *inputs, double *outputs) {
+    Diwa network;
+    network.setSeed(1);
+    if(network.initialize(2, 1, 8, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    DiwaSampler sampler;
+    sampler.setSeed(7);
+    sampler.setPriorityExponent(alpha);
+
+    if(sampler.initialize(SAMPLES) != NO_ERROR) {
+        cout << "Failed to initialize sampler" << endl;
+        exit(0);
+    }
+
+    // A pass draws as many samples as there are in the dataset,
+    // the importance correction is annealed towards 1 over the passes
+    int passes = 0;
+    double accuracy = accuracyOf(network, inputs, outputs);
+    steady_clock::time_point start = steady_clock::now();
+
+    while(accuracy < TARGET_ACCURACY && passes < MAX_PASSES) {
+        sampler.setImportanceExponent(0.4 + 0.6 * passes / MAX_PASSES);
+        sampler.train(network, 1.0, inputs, outputs, SAMPLES);
+
+        accuracy = accuracyOf(network, inputs, outputs);
+        passes++;
+    }
+
+    double elapsed = duration<double, milli>(steady_clock::now() - start).count();
+    cout << name << "\t" << passes << " passes\t| Accuracy: " << accuracy * 100 << "%"
+        << "\t| Time: " << fixed << setprecision(2) << elapsed << " ms" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a small circle,
+    // so that most samples are easy and only those near the border are not
+    static double inputs[SAMPLES][2];
+    static double outputs[SAMPLES][1];
+
+    for(int i = 0; i < SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.2;
+    }
+
+    cout << "Target accuracy: " << TARGET_ACCURACY * 100 << "%" << endl << endl;
+
+    // A priority exponent of 0 draws every sample with the same probability
+    benchmark("Uniform:", 0.0, inputs[0], outputs[0]);
+    benchmark("Prioritized:", 0.6, inputs[0], outputs[0]);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace std::chrono;
+
+#define SAMPLES 1000
+#define EPOCHS  200
+
+static double inputs[SAMPLES][2];
+static double outputs[SAMPLES][1];
+
+static void benchmark(double threshold) {
+    Diwa network;
+    network.setSeed(1);
+    if(network.initialize(2, 2, 32, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    network.setUpdateThreshold(threshold);
+    steady_clock::time_point start = steady_clock::now();
+
+    for(int epoch = 0; epoch < EPOCHS; epoch++)
+        for(int i = 0; i < SAMPLES; i++)
+            network.train(0.5, inputs[i], outputs[i]);
+
+    double elapsed = duration<double, milli>(steady_clock::now() - start).count();
+
+    int correct = 0;
+    for(int i = 0; i < SAMPLES; i++)
+        if((network.inference(inputs[i])[0] >= 0.5) == (outputs[i][0] >= 0.5))
+            correct++;
+
+    cout << "Threshold: " << setw(6) << threshold
+        << "\t| Accuracy: " << fixed << setprecision(1) << correct * 100.0 / SAMPLES << "%"
+        << "\t| Time: " << setprecision(2) << elapsed << " ms" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+int main() {
+    // Generate points on a plane, labelled 1 when inside of a circle
+    for(int i = 0; i < SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.5;
+    }
+
+    // A threshold of 0 updates every weight on every step. Higher thresholds
+    // defer the small updates into per-weight residuals: fewer weights are
+    // written, but keeping the residuals makes every step slower
+    double thresholds[] = {0, 1e-4, 1e-3, 1e-2};
+    for(double threshold : thresholds)
+        benchmark(threshold);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+#include <diwa_search.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+#define SAMPLES 2000
+
+int main() {
+    // Points on a plane, labelled 1 when inside of a ring
+    DiwaDataset dataset;
+    if(dataset.initialize(SAMPLES, 2, 1) != NO_ERROR) {
+        cout << "Failed to allocate dataset" << endl;
+        return 1;
+    }
+
+    DiwaRandom randomizer;
+    randomizer.seed(1);
+
+    for(int i = 0; i < SAMPLES; i++) {
+        double point[2] = {
+            randomizer.nextUniform(-1, 1),
+            randomizer.nextUniform(-1, 1)
+        };
+
+        const double radius = point[0] * point[0] + point[1] * point[1];
+        double label = radius > 0.2 && radius < 0.6;
+
+        dataset.setRow(i, point, &label);
+    }
+
+    dataset.setSeed(2);
+    dataset.shuffle();
+
+    // Search for the most accurate topology that fits within
+    // 1 KiB of memory, training the candidates concurrently
+    DiwaTopologySearch search;
+    search.setMemoryBudget(1024);
+    search.setSeed(3);
+
+    if(search.search(dataset, 2.0, 100, 4) != NO_ERROR) {
+        cout << "Failed to search topologies" << endl;
+        return 1;
+    }
+
+    for(int i = 0; i < search.getCandidateCount(); i++) {
+        cout << search.getHiddenLayers(i) << " x " << setw(2)
+            << search.getHiddenNeurons(i) << " hidden neurons: "
+            << fixed << setprecision(3) << search.getLatency(i) << " us, "
+            << search.getMemory(i) << " bytes, ";
+
+        if(search.getAccuracy(i) < 0)
+            cout << "over budget" << endl;
+        else cout << "accuracy " << setprecision(1)
+            << 100.0 * search.getAccuracy(i) << "%" << endl;
+    }
+
+    const int best = search.getBestCandidate();
+    if(best < 0) {
+        cout << "No topology fits within the budget" << endl;
+        return 1;
+    }
+
+    Diwa network;
+    if(search.getBestNetwork(network) != NO_ERROR) {
+        cout << "Failed to load best network" << endl;
+        return 1;
+    }
+
+    cout << "Best topology: " << network.getHiddenLayers() << " x "
+        << network.getHiddenNeurons() << " hidden neurons" << endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <diwa.h>
+#include <diwa_trainer.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+#define TRAINING_SAMPLES    300
+#define VALIDATION_SAMPLES  100
+
+int main() {
+    // Create an instance of the Diwa neural network
+    Diwa network;
+
+    // Generate points on a plane, labelled 1 when inside of a circle;
+    // the first 300 points are used for training, the rest for validation
+    static double inputs[TRAINING_SAMPLES + VALIDATION_SAMPLES][2];
+    static double outputs[TRAINING_SAMPLES + VALIDATION_SAMPLES][1];
+
+    for(int i = 0; i < TRAINING_SAMPLES + VALIDATION_SAMPLES; i++) {
+        inputs[i][0] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+        inputs[i][1] = ((double) rand() / RAND_MAX) * 2.0 - 1.0;
+
+        outputs[i][0] = (inputs[i][0] * inputs[i][0] +
+            inputs[i][1] * inputs[i][1]) < 0.5;
+    }
+
+    // Seed the weight initialization so that every run gives the same result,
+    // since the learning rate range test depends on the initial weights
+    network.setSeed(1);
+
+    // Initialize the neural network with specified parameters
+    if(network.initialize(2, 1, 8, 1) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        exit(0);
+    }
+
+    // Create a trainer for the neural network
+    DiwaTrainer trainer(network);
+
+    // Find a suitable learning rate with a learning rate range test
+    double learningRate = trainer.findLearningRate(
+        inputs[0], outputs[0], TRAINING_SAMPLES,
+        0.001, 100.0, 600
+    );
+    cout << "Suggested learning rate: " << learningRate << endl;
+
+    // Use the one-cycle schedule peaking at the suggested learning rate,
+    // and stop once the validation loss has not improved for 100 epochs
+    trainer.setLearningRate(learningRate);
+    trainer.setOneCycleSchedule(learningRate / 25, 0.3);
+    trainer.setEarlyStopping(100, 1e-5);
+
+    // Train the neural network
+    cout << "Starting neural network training... " << endl;
+    if(trainer.fit(
+        inputs[0], outputs[0], TRAINING_SAMPLES,
+        inputs[TRAINING_SAMPLES], outputs[TRAINING_SAMPLES], VALIDATION_SAMPLES,
+        400
+    ) != NO_ERROR) {
+        cout << "Failed to train neural network" << endl;
+        exit(0);
+    }
+
+    cout << "Training done after " << trainer.getEpoch() << " epochs (best epoch: "
+        << trainer.getBestEpoch() << ", validation loss: "
+        << trainer.getBestLoss() << ")" << endl << endl;
+
+    // Count the correct inferences on the validation samples
+    int correct = 0;
+    for(int i = TRAINING_SAMPLES; i < TRAINING_SAMPLES + VALIDATION_SAMPLES; i++)
+        if((network.inference(inputs[i])[0] >= 0.5) == (outputs[i][0] == 1))
+            correct++;
+
+    cout << "Validation accuracy: " << fixed << setprecision(1)
+        << (100.0 * correct / VALIDATION_SAMPLES) << "%" << endl;
+    return 0;
+}
@@ -25,16 +25,18 @@
 #   include <bootloader_random.h>
 #endif
 
-#if (defined(__GNUC__) || \
-    defined(__GNUG__) || \
-    defined(__clang__) || \
-    defined(_MSC_VER)) && \
-    !defined(ARDUINO)
-#   include <cstring>
-#endif
-
 #include <diwa.h>
 #include <diwa_conv.h>
+#include <diwa_dataset.h>
+#include <diwa_metrics.h>
+#include <string.h>
+
+#ifdef DIWA_THREADS
+#   include <condition_variable>
+#   include <mutex>
+#   include <random>
+#   include <thread>
+#endif
 
 #if (defined(__GNUC__) || \
     defined(__GNUG__) || \
@@ -52,24 +54,113 @@ static inline void writeToStream(std::ofstream& stream, const uint8_t* data, siz
     delete[] data;
 }
 
+#elif defined(ARDUINO)
+
+static inline void writeToFile(File& file, const uint8_t* data, size_t size) {
+    file.write(data, size);
+    delete[] data;
+}
+
 #endif
 
+static inline void countTopology(
+    int inputNeurons,
+    int hiddenLayers,
+    int hiddenNeurons,
+    int outputNeurons,
+    size_t *weightCount,
+    size_t *neuronCount
+) {
+    const size_t hiddenWeightCount = hiddenLayers ?
+        (size_t) (inputNeurons + 1) * hiddenNeurons +
+            (size_t) (hiddenLayers - 1) * (hiddenNeurons + 1) *
+            hiddenNeurons : 0;
+    const size_t outputWeightCount = (size_t) (hiddenLayers ?
+        (hiddenNeurons + 1) : (inputNeurons + 1)
+    ) * outputNeurons;
+
+    *weightCount = hiddenWeightCount + outputWeightCount;
+    *neuronCount = (size_t) inputNeurons +
+        (size_t) hiddenNeurons * hiddenLayers + outputNeurons;
+}
+
 Diwa::Diwa() {
+    this->inputNeurons = 0;
+    this->hiddenNeurons = 0;
+    this->hiddenLayers = 0;
+    this->outputNeurons = 0;
+    this->weightCount = 0;
+    this->neuronCount = 0;
+    this->weights = NULL;
+    this->outputs = NULL;
+    this->deltas = NULL;
     this->activation = DiwaActivationFunc::sigmoid;
+    this->activationDerivative = DiwaActivationFunc::sigmoidDerivative;
+    this->outputMode = ACTIVATION_OUTPUT;
+    this->initialization = UNIFORM_INITIALIZATION;
+    this->seeded = false;
+    this->trainableLayers = NULL;
+    this->firstTrainable = 0;
+    this->residuals = NULL;
+    this->updateThreshold = 0;
+    this->mixedPrecision = false;
+    this->reducedStale = true;
+    this->reduced = NULL;
+    this->quantizationAware = false;
+    this->quantized = NULL;
+    this->normalization = NULL;
     this->initialize(0, 0, 0, 0);
 }
 
 Diwa::~Diwa() {
     free(this->weights);
+    free(this->trainableLayers);
+    free(this->residuals);
+    free(this->reduced);
+    free(this->quantized);
+    free(this->normalization);
 }
 
 inline void Diwa::randomizeWeights() {
-    for(int i = 0; i < this->weightCount; i++)
-        #ifdef ARDUINO
-        this->weights[i] = (((double) random()) / RAND_MAX) - 0.5;
-        #else
-        this->weights[i] = (((double) rand()) / RAND_MAX) - 0.5;
-        #endif
+    double *weights = this->weights;
+    int inputCount = this->inputNeurons;
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        const int outputCount = h < this->hiddenLayers ?
+            this->hiddenNeurons : this->outputNeurons;
+        const double fanIn = inputCount;
+
+        double limit = 0.5, deviation = 0;
+        switch(this->initialization) {
+            case XAVIER_INITIALIZATION:
+                limit = sqrt(6.0 / (fanIn + outputCount));
+                break;
+
+            case HE_INITIALIZATION:
+                deviation = sqrt(2.0 / fanIn);
+                break;
+
+            case LECUN_INITIALIZATION:
+                deviation = sqrt(1.0 / fanIn);
+                break;
+
+            default:
+                break;
+        }
+
+        for(int j = 0; j < outputCount; ++j)
+            for(int k = 0; k <= inputCount; ++k) {
+                if(this->initialization == UNIFORM_INITIALIZATION)
+                    *weights++ = this->randomizer.nextUniform(-0.5, 0.5);
+                else if(k == 0)
+                    *weights++ = 0;
+                else if(deviation != 0)
+                    *weights++ = this->randomizer.nextGaussian(0, deviation);
+                else *weights++ = this->randomizer.nextUniform(-limit, limit);
+            }
+
+        inputCount = this->hiddenNeurons;
+    }
 }
 
 DiwaError Diwa::initialize(
@@ -85,36 +176,72 @@ DiwaError Diwa::initialize(
         outputNeurons == 0)
         return NO_ERROR;
 
-    #if defined(ARDUINO) && defined(ARDUINO_ARCH_ESP32) 
-    bootloader_random_enable();
-    randomSeed(esp_random());
-    bootloader_random_disable();
-    #endif
+    if(!this->seeded) {
+        #if defined(ARDUINO) && defined(ARDUINO_ARCH_ESP32)
+        bootloader_random_enable();
+        this->randomizer.seed(((uint64_t) esp_random() << 32) | esp_random());
+        bootloader_random_disable();
+        #elif defined(ARDUINO)
+        this->randomizer.seed(((uint64_t) random() << 32) ^ random());
+        #elif defined(DIWA_THREADS)
+        std::random_device device;
+        this->randomizer.seed(((uint64_t) device() << 32) ^ device());
+        #else
+        this->randomizer.seed(((uint64_t) rand() << 32) ^ rand());
+        #endif
+    }
 
-    const int hiddenWeightCount = hiddenLayers ?
-        (inputNeurons + 1) * hiddenNeurons +
-            (hiddenLayers - 1) * (hiddenNeurons + 1) *
-            hiddenNeurons : 0;
-    const int outputWeightCount = (hiddenLayers ?
-        (hiddenNeurons + 1) : (inputNeurons + 1)
-    ) * outputNeurons;
+    size_t weightCount, neuronCount;
+    countTopology(
+        inputNeurons, hiddenLayers,
+        hiddenNeurons, outputNeurons,
+        &weightCount, &neuronCount
+    );
+
+    bool *trainableLayers = (bool*) realloc(
+        this->trainableLayers,
+        sizeof(bool) * (hiddenLayers + 1)
+    );
+    if(trainableLayers == NULL)
+        return MALLOC_FAILED;
+
+    for(int h = 0; h <= hiddenLayers; ++h)
+        trainableLayers[h] = true;
+
+    this->trainableLayers = trainableLayers;
+    this->firstTrainable = 0;
+
+    free(this->residuals);
+    this->residuals = NULL;
+
+    free(this->reduced);
+    this->reduced = NULL;
+    this->reducedStale = true;
+
+    free(this->quantized);
+    this->quantized = NULL;
+
+    free(this->normalization);
+    this->normalization = NULL;
 
     this->inputNeurons = inputNeurons;
     this->hiddenLayers = hiddenLayers;
     this->hiddenNeurons = hiddenNeurons;
     this->outputNeurons = outputNeurons;
 
-    this->weightCount = hiddenWeightCount + outputWeightCount;
-    this->neuronCount = inputNeurons + hiddenNeurons * hiddenLayers + outputNeurons;
+    this->weightCount = (int) weightCount;
+    this->neuronCount = (int) neuronCount;
 
-    if(randomizeWeights) {
-        DiwaError error;
-        if((error = this->initializeWeights()) != NO_ERROR)
-            return error;
-    }
+    DiwaError error;
+    if((error = this->initializeWeights()) != NO_ERROR)
+        return error;
 
-    this->outputs = this->weights + this->weightCount;
-    this->deltas = this->outputs + this->neuronCount;
+    if(this->updateThreshold > 0 &&
+        (this->residuals = (double*) calloc(
+            this->weightCount,
+            sizeof(double)
+        )) == NULL)
+        return MALLOC_FAILED;
 
     if(randomizeWeights)
         this->randomizeWeights();
@@ -123,192 +250,1002 @@ DiwaError Diwa::initialize(
 }
 
 DiwaError Diwa::initializeWeights() {
+    const size_t size = sizeof(double) *
+        ((size_t) this->weightCount + 2 * (size_t) this->neuronCount);
+    free(this->weights);
+
     #if defined(ARDUINO) && defined(ARDUINO_ARCH_ESP32)
     if(psramFound())
-        this->weights = (double*) ps_malloc(sizeof(double) * (this->weightCount * this->neuronCount));
-    else this->weights = (double*) malloc(sizeof(double) * (this->weightCount * this->neuronCount));
+        this->weights = (double*) ps_malloc(size);
+    else this->weights = (double*) malloc(size);
     #else
-    this->weights = (double*) malloc(sizeof(double) * (this->weightCount * this->neuronCount));
+    this->weights = (double*) malloc(size);
     #endif
 
-    if(this->weights == NULL)
+    if(this->weights == NULL) {
+        this->outputs = NULL;
+        this->deltas = NULL;
+        this->weightCount = 0;
+        this->neuronCount = 0;
+
         return MALLOC_FAILED;
+    }
+
+    this->outputs = this->weights + this->weightCount;
+    this->deltas = this->outputs + this->neuronCount;
 
     return NO_ERROR;
 }
 
-double* Diwa::inference(double *inputNeurons) {
-    double *weights = this->weights;
-    double *inputs = this->outputs;
-    double *outputs = this->outputs + this->inputNeurons;
-
-    memcpy(this->outputs, inputNeurons, sizeof(double) * this->inputNeurons);
-    if(!this->hiddenLayers) {
-        double *returnValues = outputs;
-        for(int j = 0; j < this->outputNeurons; ++j) {
-            double sum = *weights++ * -1.0;
-
-            for(int k = 0; k < this->inputNeurons; ++k)
-                sum += *weights++ * inputs[k];
-            *outputs++ = this->activation(sum);
+template<typename T>
+static inline const T* propagateLayer(
+    const T *weights,
+    const T *inputs,
+    int inputCount,
+    T *outputs,
+    int outputCount,
+    diwa_activation activation,
+    diwa_activation_derivative derivative,
+    T *derivatives
+) {
+    for(int j = 0; j < outputCount; ++j) {
+        T sum = *weights++ * (T) -1.0;
+
+        for(int k = 0; k < inputCount; ++k)
+            sum += *weights++ * inputs[k];
+
+        double output = activation(sum);
+        if(derivatives)
+            derivatives[j] = (T) derivative(sum, output);
+
+        outputs[j] = (T) output;
+    }
+
+    return weights;
+}
+
+#define DIWA_FLOAT_LANES 8 /**< Independent partial sums of a single-precision dot product */
+
+// Keeps DIWA_FLOAT_LANES independent partial sums so that the
+// compiler can vectorize the loop without reassociating floats
+static inline float dotProduct(const float *weights, const float *inputs, int count) {
+    float partial[DIWA_FLOAT_LANES] = {0};
+    int k = 0;
+
+    for(; k + DIWA_FLOAT_LANES <= count; k += DIWA_FLOAT_LANES)
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            partial[l] += weights[k + l] * inputs[k + l];
+
+    float sum = 0;
+    for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+        sum += partial[l];
+
+    for(; k < count; ++k)
+        sum += weights[k] * inputs[k];
+    return sum;
+}
+
+// Applies a built-in activation function and its derivative to a whole
+// layer in single precision, falling back to the double precision
+// function pointers for custom activation functions
+static inline void activateLayer(
+    float *outputs,
+    float *derivatives,
+    int count,
+    diwa_activation activation,
+    diwa_activation_derivative derivative
+) {
+    const float lower = DIWA_ACTFUNC_LOWER_BOUND;
+    const float upper = DIWA_ACTFUNC_UPPER_BOUND;
+
+    // A custom derivative paired with a built-in function takes the fallback
+    const diwa_activation kernel = derivatives == NULL ||
+        derivative == DiwaActivationFunc::derivativeOf(activation) ?
+        activation : NULL;
+
+    if(kernel == DiwaActivationFunc::sigmoid)
+        for(int j = 0; j < count; ++j) {
+            const float x = outputs[j];
+            const float y = x < lower ? 0.0f : x > upper ? 1.0f :
+                1.0f / (1.0f + expf(-x));
+
+            outputs[j] = y;
+            if(derivatives)
+                derivatives[j] = y * (1.0f - y);
+        }
+    else if(kernel == DiwaActivationFunc::tanh)
+        for(int j = 0; j < count; ++j) {
+            const float x = outputs[j];
+            const float y = x < lower ? -1.0f : x > upper ? 1.0f : tanhf(x);
+
+            outputs[j] = y;
+            if(derivatives)
+                derivatives[j] = 1.0f - y * y;
         }
+    else if(kernel == DiwaActivationFunc::gaussian)
+        for(int j = 0; j < count; ++j) {
+            const float x = outputs[j];
+            const bool clamped = x < lower || x > upper;
+            const float y = x < lower ? 0.0f : x > upper ? 1.0f : 1.0f / expf(x * x);
+
+            outputs[j] = y;
+            if(derivatives)
+                derivatives[j] = clamped ? 0.0f : -2.0f * x * y;
+        }
+    else if(kernel == DiwaActivationFunc::relu)
+        for(int j = 0; j < count; ++j) {
+            const float x = outputs[j];
+
+            outputs[j] = x > 0 ? x : 0.0f;
+            if(derivatives)
+                derivatives[j] = x > 0 ? 1.0f : 0.0f;
+        }
+    else if(kernel == DiwaActivationFunc::leakyReLU) {
+        const float slope = (float) DiwaActivationFunc::getLeakyReLUSlope();
 
-        return returnValues;
+        for(int j = 0; j < count; ++j) {
+            const float x = outputs[j];
+
+            outputs[j] = x > 0 ? x : x * slope;
+            if(derivatives)
+                derivatives[j] = x > 0 ? 1.0f : slope;
+        }
     }
+    else if(kernel == DiwaActivationFunc::hardSigmoid)
+        for(int j = 0; j < count; ++j) {
+            float y = 0.2f * outputs[j] + 0.5f;
+            y = y < 0 ? 0.0f : y > 1 ? 1.0f : y;
+
+            outputs[j] = y;
+            if(derivatives)
+                derivatives[j] = y > 0 && y < 1 ? 0.2f : 0.0f;
+        }
+    else for(int j = 0; j < count; ++j) {
+        const double sum = outputs[j];
+        const double output = activation(sum);
 
-    for(int j = 0; j < this->hiddenNeurons; ++j) {
-        double sum = *weights++ * -1.0;
+        outputs[j] = (float) output;
+        if(derivatives)
+            derivatives[j] = (float) derivative(sum, output);
+    }
+}
 
-        for(int k = 0; k < this->inputNeurons; ++k)
-            sum += *weights++ * inputs[k];
-        *outputs++ = this->activation(sum);
+static inline const float* propagateLayer(
+    const float *weights,
+    const float *inputs,
+    int inputCount,
+    float *outputs,
+    int outputCount,
+    diwa_activation activation,
+    diwa_activation_derivative derivative,
+    float *derivatives
+) {
+    for(int j = 0; j < outputCount; ++j) {
+        outputs[j] = dotProduct(weights + 1, inputs, inputCount) - weights[0];
+        weights += inputCount + 1;
     }
 
-    inputs += this->inputNeurons;
-    for(int h = 1; h < this->hiddenLayers; ++h) {
-        for(int j = 0; j < this->hiddenNeurons; ++j) {
-            double sum = *weights++ * -1.0;
-            
-            for(int k = 0; k < this->hiddenNeurons; ++k)
-                sum += *weights++ * inputs[k];
-            *outputs++ = this->activation(sum);
+    activateLayer(outputs, derivatives, outputCount, activation, derivative);
+    return weights;
+}
+
+template<typename T>
+static inline void backpropagateLayer(
+    T *deltas,
+    const T *forwardDeltas,
+    const T *forwardWeights,
+    int count,
+    int forwardCount
+) {
+    for(int j = 0; j < count; ++j) {
+        T delta = 0;
+
+        for(int k = 0; k < forwardCount; ++k)
+            delta += forwardDeltas[k] *
+                forwardWeights[k * (count + 1) + (j + 1)];
+
+        deltas[j] *= delta;
+    }
+}
+
+// Walks DIWA_FLOAT_LANES neurons at once, so that the weights are read
+// along their rows; every delta keeps the same order of additions
+static inline void backpropagateLayer(
+    float *deltas,
+    const float *forwardDeltas,
+    const float *forwardWeights,
+    int count,
+    int forwardCount
+) {
+    int j = 0;
+
+    for(; j + DIWA_FLOAT_LANES <= count; j += DIWA_FLOAT_LANES) {
+        float sums[DIWA_FLOAT_LANES] = {0};
+
+        for(int k = 0; k < forwardCount; ++k) {
+            const float *row = forwardWeights + k * (count + 1) + (j + 1);
+            const float delta = forwardDeltas[k];
+
+            for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+                sums[l] += delta * row[l];
         }
 
-        inputs += this->hiddenNeurons;
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            deltas[j + l] *= sums[l];
     }
 
-    double* returnValue = outputs;
-    for(int j = 0; j < this->outputNeurons; ++j) {
-        double sum = *weights++ * -1.0;
+    for(; j < count; ++j) {
+        float delta = 0;
+
+        for(int k = 0; k < forwardCount; ++k)
+            delta += forwardDeltas[k] *
+                forwardWeights[k * (count + 1) + (j + 1)];
 
-        for(int k = 0; k < this->hiddenNeurons; ++k)
+        deltas[j] *= delta;
+    }
+}
+
+template<typename T>
+static inline void computeLogits(
+    const T *weights,
+    const T *inputs,
+    int inputCount,
+    T *outputs,
+    int outputCount
+) {
+    for(int j = 0; j < outputCount; ++j) {
+        T sum = *weights++ * (T) -1.0;
+
+        for(int k = 0; k < inputCount; ++k)
             sum += *weights++ * inputs[k];
-        *outputs++ = this->activation(sum);;
+        outputs[j] = sum;
+    }
+}
+
+template<typename T>
+static inline void softmax(T *outputs, int count) {
+    T max = outputs[0];
+    for(int j = 1; j < count; ++j)
+        max = outputs[j] > max ? outputs[j] : max;
+
+    double sum = 0;
+    for(int j = 0; j < count; ++j) {
+        outputs[j] = (T) exp(outputs[j] - max);
+        sum += outputs[j];
+    }
+
+    const T scale = (T) (1.0 / sum);
+    for(int j = 0; j < count; ++j)
+        outputs[j] *= scale;
+}
+
+static inline int argmax(double *values, int count) {
+    int index = 0;
+
+    for(int j = 1; j < count; ++j)
+        if(values[j] > values[index])
+            index = j;
+
+    return index;
+}
+
+// Loads each block of inputs before storing it, since the inputs and the
+// float copy of the weights share a buffer that would keep the compiler
+// from vectorizing the update
+template<typename T>
+static inline void updateReduced(
+    double *weights,
+    float *reduced,
+    const T *inputs,
+    double delta,
+    int count
+) {
+    int k = 0;
+
+    for(; k + DIWA_FLOAT_LANES <= count; k += DIWA_FLOAT_LANES) {
+        T x[DIWA_FLOAT_LANES];
+        double w[DIWA_FLOAT_LANES];
+
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            x[l] = inputs[k + l];
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            w[l] = weights[k + l] + delta * x[l];
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            weights[k + l] = w[l];
+        for(int l = 0; l < DIWA_FLOAT_LANES; ++l)
+            reduced[k + l] = (float) w[l];
+    }
+
+    for(; k < count; ++k)
+        reduced[k] = (float) (weights[k] += delta * inputs[k]);
+}
+
+// Adds an update to the residual of a weight, and applies the sum to
+// the weight once its magnitude reaches the threshold
+static inline void updateWeight(
+    double *weight,
+    double *residual,
+    float *reduced,
+    double update,
+    double threshold
+) {
+    update += *residual;
+
+    if(fabs(update) < threshold) {
+        *residual = update;
+        return;
+    }
+
+    *residual = 0;
+    *weight += update;
+
+    if(reduced != NULL)
+        *reduced = (float) *weight;
+}
+
+template<typename T>
+static inline void updateLayer(
+    double *weights,
+    const T *deltas,
+    const T *inputs,
+    int inputCount,
+    int outputCount,
+    double learningRate,
+    double *residuals,
+    double threshold,
+    float *reduced
+) {
+    for(int j = 0; j < outputCount; ++j) {
+        double delta = deltas[j] * learningRate;
+
+        if(residuals != NULL) {
+            updateWeight(weights++, residuals++, reduced, delta * -1.0, threshold);
+            if(reduced != NULL)
+                reduced++;
+
+            for(int k = 0; k < inputCount; ++k) {
+                updateWeight(weights++, residuals++, reduced, delta * inputs[k], threshold);
+                if(reduced != NULL)
+                    reduced++;
+            }
+
+            continue;
+        }
+
+        if(reduced != NULL) {
+            *reduced++ = (float) (*weights++ += delta * -1.0);
+
+            updateReduced(weights, reduced, inputs, delta, inputCount);
+            weights += inputCount;
+            reduced += inputCount;
+            continue;
+        }
+
+        *weights++ += delta * -1.0;
+
+        for(int k = 0; k < inputCount; ++k)
+            *weights++ += delta * inputs[k];
+    }
+}
+
+template<typename T, typename I>
+static inline void loadInputs(T *outputs, const I *inputs, int count) {
+    for(int i = 0; i < count; ++i)
+        outputs[i] = (T) inputs[i];
+}
+
+template<typename T>
+static inline void loadInputs(T *outputs, const T *inputs, int count) {
+    if(outputs != inputs)
+        memcpy(outputs, inputs, sizeof(T) * count);
+}
+
+template<typename T, typename I>
+T* Diwa::forward(
+    const T *weights,
+    T *outputs,
+    const I *inputNeurons,
+    T *derivatives,
+    bool logits
+) const {
+    const T *inputs = outputs;
+    int inputCount = this->inputNeurons;
+
+    loadInputs(outputs, inputNeurons, this->inputNeurons);
+    outputs += this->inputNeurons;
+
+    for(int h = 0; h < this->hiddenLayers; ++h) {
+        weights = propagateLayer(
+            weights, inputs, inputCount,
+            outputs, this->hiddenNeurons,
+            this->activation,
+            this->activationDerivative,
+            derivatives
+        );
+
+        inputs = outputs;
+        inputCount = this->hiddenNeurons;
+
+        outputs += this->hiddenNeurons;
+        if(derivatives)
+            derivatives += this->hiddenNeurons;
     }
 
-    return returnValue;
+    if(this->outputMode == SOFTMAX_OUTPUT) {
+        computeLogits(weights, inputs, inputCount, outputs, this->outputNeurons);
+
+        if(!logits)
+            softmax(outputs, this->outputNeurons);
+    }
+    else propagateLayer(
+        weights, inputs, inputCount,
+        outputs, this->outputNeurons,
+        this->activation,
+        this->activationDerivative,
+        derivatives
+    );
+
+    return outputs;
 }
 
-void Diwa::train(double learningRate, double *inputNeurons, double *outputNeurons) {
-    this->inference(inputNeurons);
+template double* Diwa::forward<double>(
+    const double*, double*,
+    const double*, double*,
+    bool
+) const;
+
+double* Diwa::forwardPass(double *inputNeurons, bool training) {
+    return this->forward(
+        this->weights,
+        this->outputs,
+        inputNeurons,
+        training ? this->deltas : NULL,
+        false
+    );
+}
+
+double* Diwa::inference(double *inputNeurons) {
+    return this->forwardPass(inputNeurons, false);
+}
+
+double* Diwa::inference(const float *inputNeurons) {
+    return this->forward<double>(this->weights, this->outputs, inputNeurons, NULL, false);
+}
+
+double* Diwa::inference(const int16_t *inputNeurons) {
+    return this->forward<double>(this->weights, this->outputs, inputNeurons, NULL, false);
+}
+
+double* Diwa::inference(const uint16_t *inputNeurons) {
+    return this->forward<double>(this->weights, this->outputs, inputNeurons, NULL, false);
+}
+
+double* Diwa::inference(const uint8_t *inputNeurons) {
+    return this->forward<double>(this->weights, this->outputs, inputNeurons, NULL, false);
+}
+
+int Diwa::classify(double *inputNeurons) {
+    return argmax(
+        this->forward<double>(
+            this->weights,
+            this->outputs,
+            inputNeurons,
+            NULL,
+            true
+        ),
+        this->outputNeurons
+    );
+}
+
+template<typename T>
+double Diwa::backpropagate(
+    const T *weights,
+    const T *outputs,
+    T *deltas,
+    const double *outputNeurons
+) const {
+    double loss = 0;
 
     {
-        double *outputs =
-            this->outputs +
+        const T *outputLayer =
+            outputs +
             this->inputNeurons +
             this->hiddenNeurons *
             this->hiddenLayers;
-        double *deltas =
-            this->deltas +
+        T *outputDeltas =
+            deltas +
             this->hiddenNeurons *
             this->hiddenLayers;
-        double *training = outputNeurons;
 
-        for(int j = 0; j < this->outputNeurons; ++j) {
-            *deltas++ = (*training - *outputs) *
-                *outputs * (1.0 - *outputs);
-            outputs++, training++;
+        if(this->outputMode == SOFTMAX_OUTPUT)
+            for(int j = 0; j < this->outputNeurons; ++j) {
+                outputDeltas[j] = (T) (outputNeurons[j] - outputLayer[j]);
+
+                if(outputNeurons[j] != 0)
+                    loss -= outputNeurons[j] * log(
+                        outputLayer[j] > 1e-12 ? (double) outputLayer[j] : 1e-12
+                    );
+            }
+        else for(int j = 0; j < this->outputNeurons; ++j) {
+            double error = outputNeurons[j] - outputLayer[j];
+
+            outputDeltas[j] *= (T) error;
+            loss += 0.5 * error * error;
         }
     }
 
-    for(int h = this->hiddenLayers - 1; h >= 0; --h) {
-        double *outputs =
-            this->outputs +
-            this->inputNeurons +
-            (h * this->hiddenNeurons);
-
-        double *deltas =
-            this->deltas +
+    for(int h = this->hiddenLayers - 1; h >= this->firstTrainable; --h) {
+        T *layerDeltas =
+            deltas +
             (h * this->hiddenNeurons);
 
-        double *firstDelta =
-            this->deltas +
+        const T *forwardDeltas =
+            deltas +
             ((h + 1) * this->hiddenNeurons);
 
-        double *firstWeight =
-            this->weights +
+        const T *forwardWeights =
+            weights +
             ((this->inputNeurons + 1) * this->hiddenNeurons) +
             ((this->hiddenNeurons + 1) * this->hiddenNeurons * h);
 
-        for(int j = 0; j < this->hiddenNeurons; ++j) {
-            double delta = 0;
+        const int forwardCount = h == this->hiddenLayers - 1 ?
+            this->outputNeurons :
+            this->hiddenNeurons;
 
-            for(int k = 0;
-                k < (h == this->hiddenLayers - 1 ?
-                    this->outputNeurons :
-                    this->hiddenNeurons);
-                ++k) {
-                int weightIndex = k * (this->hiddenNeurons + 1) + (j + 1);
+        backpropagateLayer(
+            layerDeltas, forwardDeltas, forwardWeights,
+            this->hiddenNeurons, forwardCount
+        );
+    }
 
-                double forwardDelta = firstDelta[k];
-                double forwardWeight = firstWeight[weightIndex];
+    return loss;
+}
 
-                delta += forwardDelta * forwardWeight;
-            }
+template<typename T>
+void Diwa::applyDeltas(
+    double *weights,
+    const T *outputs,
+    const T *deltas,
+    double learningRate,
+    double *residuals,
+    float *reduced
+) const {
+    const T *inputs = outputs;
+    int inputCount = this->inputNeurons;
+
+    for(int h = 0; h < this->hiddenLayers; ++h) {
+        if(h >= this->firstTrainable)
+            updateLayer(
+                weights, deltas, inputs,
+                inputCount, this->hiddenNeurons,
+                learningRate, residuals,
+                this->updateThreshold,
+                reduced
+            );
+
+        weights += (inputCount + 1) * this->hiddenNeurons;
+        inputs += inputCount;
+        deltas += this->hiddenNeurons;
+
+        if(residuals != NULL)
+            residuals += (inputCount + 1) * this->hiddenNeurons;
+        if(reduced != NULL)
+            reduced += (inputCount + 1) * this->hiddenNeurons;
+
+        inputCount = this->hiddenNeurons;
+    }
+
+    if(this->firstTrainable <= this->hiddenLayers)
+        updateLayer(
+            weights, deltas, inputs,
+            inputCount, this->outputNeurons,
+            learningRate, residuals,
+            this->updateThreshold,
+            reduced
+        );
+}
+
+DiwaError Diwa::synchronizeReduced() {
+    if(this->reduced == NULL) {
+        this->reduced = (float*) malloc(
+            sizeof(float) * (this->weightCount + 2 * this->neuronCount)
+        );
+
+        if(this->reduced == NULL)
+            return MALLOC_FAILED;
+    }
+
+    for(int i = 0; i < this->weightCount; i++)
+        this->reduced[i] = (float) this->weights[i];
+
+    this->reducedStale = false;
+    return NO_ERROR;
+}
+
+double Diwa::quantizationScale(int layer, int *offset, int *count) const {
+    const int start = layer == 0 ? 0 :
+        (this->inputNeurons + 1) * this->hiddenNeurons +
+        (layer - 1) * (this->hiddenNeurons + 1) * this->hiddenNeurons;
+    const int length = (layer == 0 ? this->inputNeurons + 1 : this->hiddenNeurons + 1) *
+        (layer < this->hiddenLayers ? this->hiddenNeurons : this->outputNeurons);
+
+    double max = 0;
+    for(int i = start; i < start + length; i++)
+        if(fabs(this->weights[i]) > max)
+            max = fabs(this->weights[i]);
+
+    if(offset != NULL)
+        *offset = start;
+    if(count != NULL)
+        *count = length;
+
+    return max / 127.0;
+}
 
-            *deltas = *outputs * (1.0 - *outputs) * delta;
-            deltas++, outputs++;
+DiwaError Diwa::fakeQuantize() {
+    if(this->quantized == NULL) {
+        this->quantized = (double*) malloc(sizeof(double) * this->weightCount);
+
+        if(this->quantized == NULL)
+            return MALLOC_FAILED;
+    }
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        int offset, count;
+        const double scale = this->quantizationScale(h, &offset, &count);
+
+        for(int i = offset; i < offset + count; i++)
+            this->quantized[i] = scale > 0 ?
+                round(this->weights[i] / scale) * scale : 0;
+    }
+
+    return NO_ERROR;
+}
+
+double Diwa::train(double learningRate, double *inputNeurons, double *outputNeurons) {
+    if(this->quantizationAware && this->fakeQuantize() == NO_ERROR) {
+        this->forward(this->quantized, this->outputs, inputNeurons, this->deltas, false);
+
+        double loss = this->backpropagate(this->quantized, this->outputs, this->deltas, outputNeurons);
+        this->applyDeltas(
+            this->weights, this->outputs, this->deltas,
+            learningRate, this->residuals,
+            (float*) NULL
+        );
+
+        this->reducedStale = true;
+        return loss;
+    }
+
+    if(this->mixedPrecision &&
+        (!this->reducedStale || this->synchronizeReduced() == NO_ERROR)) {
+        float *outputs = this->reduced + this->weightCount;
+        float *deltas = outputs + this->neuronCount;
+
+        for(int i = 0; i < this->inputNeurons; i++)
+            outputs[i] = (float) inputNeurons[i];
+        this->forward(this->reduced, outputs, outputs, deltas, false);
+
+        double loss = this->backpropagate(this->reduced, outputs, deltas, outputNeurons);
+        this->applyDeltas(
+            this->weights, outputs, deltas,
+            learningRate, this->residuals,
+            this->reduced
+        );
+
+        return loss;
+    }
+
+    this->forwardPass(inputNeurons, true);
+
+    double loss = this->backpropagate(this->weights, this->outputs, this->deltas, outputNeurons);
+    this->applyDeltas(
+        this->weights, this->outputs, this->deltas,
+        learningRate, this->residuals,
+        (float*) NULL
+    );
+
+    this->reducedStale = true;
+    return loss;
+}
+
+double Diwa::calculateGradient(double *inputs, double *targets, int samples, double *gradient) {
+    memset(gradient, 0, sizeof(double) * this->weightCount);
+    if(samples <= 0)
+        return 0;
+
+    double loss = 0;
+    for(int i = 0; i < samples; i++) {
+        this->forwardPass(inputs + i * this->inputNeurons, true);
+        loss += this->backpropagate(
+            this->weights, this->outputs, this->deltas,
+            targets + i * this->outputNeurons
+        );
+
+        this->applyDeltas(
+            gradient, this->outputs, this->deltas,
+            -1.0 / samples, NULL,
+            (float*) NULL
+        );
+    }
+
+    return loss / samples;
+}
+
+DiwaError Diwa::fit(
+    double learningRate,
+    DiwaDataset& dataset,
+    int epochs,
+    int batchSize,
+    int threads
+) {
+    const int samples = dataset.getSampleCount();
+    if(epochs <= 0 || batchSize <= 0 || samples <= 0 ||
+        this->weightCount <= 0 ||
+        dataset.getInputCount() != this->inputNeurons ||
+        dataset.getTargetCount() != this->outputNeurons)
+        return INVALID_PARAM_VALUES;
+
+    if(batchSize == 1 || samples == 1) {
+        for(int epoch = 0; epoch < epochs; epoch++) {
+            dataset.shuffle();
+
+            for(int i = 0; i < samples; i++)
+                this->train(
+                    learningRate,
+                    dataset.getSampleInputs(i),
+                    dataset.getSampleTargets(i)
+                );
         }
+
+        return NO_ERROR;
     }
 
-    {
-        double *deltas =
-            this->deltas +
-            this->hiddenNeurons *
-            this->hiddenLayers;
+    #ifdef DIWA_THREADS
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    threads = 1;
+    #endif
+
+    if(threads <= 0)
+        threads = 1;
+    if(threads > batchSize)
+        threads = batchSize;
+
+    // Weights of the frozen layers are never written
+    const int count = this->weightCount;
+    const int offset = this->getTrainableOffset();
+
+    double *steps = (double*) malloc(sizeof(double) * (
+        threads * count +
+        (threads - 1) * 2 * this->neuronCount
+    ));
+
+    if(steps == NULL)
+        return MALLOC_FAILED;
+
+    int first = 0, size = 0;
+    auto accumulate = [&](int worker) {
+        double *step = steps + worker * count;
+        double *outputs = worker == 0 ? this->outputs :
+            steps + threads * count + (worker - 1) * 2 * this->neuronCount;
+        double *deltas = worker == 0 ? this->deltas : outputs + this->neuronCount;
+
+        memset(step, 0, sizeof(double) * count);
+        for(int i = first + size * worker / threads;
+            i < first + size * (worker + 1) / threads; i++) {
+            this->forward(this->weights, outputs, dataset.getSampleInputs(i), deltas, false);
+            this->backpropagate(this->weights, outputs, deltas, dataset.getSampleTargets(i));
+
+            this->applyDeltas(
+                step, outputs, deltas,
+                learningRate / size, NULL,
+                (float*) NULL
+            );
+        }
+    };
+
+    #ifdef DIWA_THREADS
+    std::mutex lock;
+    std::condition_variable wake, done;
+    int issued = 0, pending = 0;
+    bool stop = false;
+
+    std::thread *workers = new std::thread[threads - 1];
+    for(int t = 1; t < threads; t++)
+        workers[t - 1] = std::thread([&, t]() {
+            for(int seen = 0;;) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    wake.wait(guard, [&]() { return stop || issued != seen; });
+
+                    if(stop)
+                        return;
+                    seen = issued;
+                }
+
+                accumulate(t);
+
+                std::lock_guard<std::mutex> guard(lock);
+                if(--pending == 0)
+                    done.notify_one();
+            }
+        });
+    #endif
+
+    for(int epoch = 0; epoch < epochs; epoch++) {
+        dataset.shuffle();
+
+        for(first = 0; first < samples; first += batchSize) {
+            size = samples - first < batchSize ? samples - first : batchSize;
 
-        double *weights =
-            this->weights +
-            (this->hiddenLayers ?
-                (this->inputNeurons + 1) * this->hiddenNeurons +
-                (this->hiddenNeurons + 1) * this->hiddenNeurons *
-                (this->hiddenLayers - 1) : 0);
-
-        double *firstOutput =
-            this->outputs +
-            (this->hiddenLayers ?
-                (this->inputNeurons + this->hiddenNeurons *
-                    (this->hiddenLayers - 1)) : 0);
-
-        for(int j = 0; j < this->outputNeurons; ++j) {
-            *weights++ += *deltas * learningRate * -1.0;
-
-            for(int k = 1;
-                k < (this->hiddenLayers ?
-                    this->hiddenNeurons : this->inputNeurons) + 1;
-                ++k)
-                *weights++ += *deltas * learningRate * firstOutput[k - 1];
-
-            deltas++;
+            #ifdef DIWA_THREADS
+            if(threads > 1) {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    issued++;
+                    pending = threads - 1;
+                }
+                wake.notify_all();
+            }
+            #endif
+
+            accumulate(0);
+
+            #ifdef DIWA_THREADS
+            if(threads > 1) {
+                std::unique_lock<std::mutex> guard(lock);
+                done.wait(guard, [&]() { return pending == 0; });
+            }
+            #endif
+
+            for(int t = 1; t < threads; t++)
+                for(int i = offset; i < count; i++)
+                    steps[i] += steps[t * count + i];
+
+            for(int i = offset; i < count; i++)
+                this->weights[i] += steps[i];
         }
     }
 
-    for(int h = this->hiddenLayers - 1; h >= 0; --h) {
-        double *deltas = this->deltas +
-            (h * this->hiddenNeurons);
+    #ifdef DIWA_THREADS
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    wake.notify_all();
+
+    for(int t = 1; t < threads; t++)
+        workers[t - 1].join();
+    delete[] workers;
+    #endif
 
-        double *firstInput = this->outputs +
-            (h ? this->inputNeurons +
-                this->hiddenNeurons * (h - 1) : 0);
+    free(steps);
 
-        double *weights =
-            this->weights + (h ?
-                (this->inputNeurons + 1) * this->hiddenNeurons +
-                (this->hiddenNeurons + 1) * this->hiddenNeurons *
-                (h - 1) : 0);
+    this->reducedStale = true;
+    return NO_ERROR;
+}
 
-        for(int j = 0; j < this->hiddenNeurons; ++j) {
-            *weights += *deltas * learningRate * -1.0;
+DiwaError Diwa::evaluate(
+    const DiwaDataset& dataset,
+    DiwaMetrics& metrics,
+    int threads
+) const {
+    const int samples = dataset.getSampleCount();
+    if(samples <= 0 || this->weightCount <= 0 ||
+        dataset.getInputCount() != this->inputNeurons ||
+        dataset.getTargetCount() != this->outputNeurons)
+        return INVALID_PARAM_VALUES;
+
+    #ifdef DIWA_THREADS
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    threads = 1;
+    #endif
+
+    if(threads <= 0)
+        threads = 1;
+    if(threads > samples)
+        threads = samples;
+
+    const int classes = this->outputNeurons == 1 ? 2 : this->outputNeurons;
+    const int cells = classes * classes;
+
+    DiwaError error;
+    if((error = metrics.reset(classes)) != NO_ERROR)
+        return error;
+
+    double *scratch = (double*) malloc(sizeof(double) * threads * (this->neuronCount + 2));
+    int *confusion = (int*) calloc((size_t) threads * cells, sizeof(int));
+
+    if(scratch == NULL || confusion == NULL) {
+        free(scratch);
+        free(confusion);
+
+        return MALLOC_FAILED;
+    }
+
+    auto evaluateRange = [&](int worker) {
+        double *outputs = scratch + worker * this->neuronCount;
+        double *sums = scratch + threads * this->neuronCount + 2 * worker;
+        int *counts = confusion + worker * cells;
+
+        double squaredError = 0, crossEntropy = 0;
+        for(int i = (int) ((long long) samples * worker / threads);
+            i < (int) ((long long) samples * (worker + 1) / threads); i++) {
+            const double *targets = dataset.getSampleTargets(i);
+            const double *result = this->forward<double>(
+                this->weights, outputs,
+                dataset.getSampleInputs(i),
+                NULL, false
+            );
+
+            int expected = 0, predicted = 0;
+            for(int j = 0; j < this->outputNeurons; j++) {
+                const double p = result[j] < 1e-12 ? 1e-12 :
+                    (result[j] > 1 - 1e-12 ? 1 - 1e-12 : result[j]);
+
+                squaredError += (result[j] - targets[j]) * (result[j] - targets[j]);
+                if(this->outputMode == SOFTMAX_OUTPUT)
+                    crossEntropy -= targets[j] * log(p);
+                else crossEntropy -= targets[j] * log(p) + (1 - targets[j]) * log(1 - p);
+
+                if(targets[j] > targets[expected])
+                    expected = j;
+                if(result[j] > result[predicted])
+                    predicted = j;
+            }
 
-            for(int k = 1;
-                k < (h == 0 ?
-                    this->inputNeurons : this->hiddenNeurons) + 1;
-                ++k)
-                *weights++ += *deltas * learningRate * firstInput[k - 1];
+            if(this->outputNeurons == 1) {
+                expected = targets[0] >= 0.5;
+                predicted = result[0] >= 0.5;
+            }
 
-            deltas++;
+            counts[expected * classes + predicted]++;
         }
+
+        sums[0] = squaredError;
+        sums[1] = crossEntropy;
+    };
+
+    #ifdef DIWA_THREADS
+    std::thread *workers = new std::thread[threads - 1];
+    for(int t = 1; t < threads; t++)
+        workers[t - 1] = std::thread(evaluateRange, t);
+    #endif
+
+    evaluateRange(0);
+
+    #ifdef DIWA_THREADS
+    for(int t = 1; t < threads; t++)
+        workers[t - 1].join();
+    delete[] workers;
+    #endif
+
+    double squaredError = 0, crossEntropy = 0;
+    for(int t = 0; t < threads; t++) {
+        squaredError += scratch[threads * this->neuronCount + 2 * t];
+        crossEntropy += scratch[threads * this->neuronCount + 2 * t + 1];
+
+        for(int c = 0; c < cells; c++)
+            metrics.confusion[c] += confusion[t * cells + c];
     }
+
+    int correct = 0;
+    for(int c = 0; c < classes; c++)
+        correct += metrics.confusion[c * classes + c];
+
+    metrics.samples = samples;
+    metrics.meanSquaredError = squaredError / ((double) samples * this->outputNeurons);
+    metrics.crossEntropy = crossEntropy / samples;
+    metrics.accuracy = (double) correct / samples;
+
+    free(scratch);
+    free(confusion);
+
+    return NO_ERROR;
 }
 
 #ifdef ARDUINO
@@ -350,9 +1287,6 @@ DiwaError Diwa::loadFromFile(File annFile) {
                 false
             )) != NO_ERROR)
             return error;
-
-        if((error = this->initializeWeights()) != NO_ERROR)
-            return error;
     }
 
     uint8_t temp_db[8];
@@ -361,23 +1295,63 @@ DiwaError Diwa::loadFromFile(File annFile) {
         this->weights[i] = DiwaConv::u8aToDouble(temp_db);
     }
 
+    this->outputMode = ACTIVATION_OUTPUT;
+
+    uint8_t tag[4];
+    while(annFile.read(tag, 4) == 4) {
+        annFile.read(temp_int, 4);
+        int length = DiwaConv::u8aToInt(temp_int);
+
+        if(memcmp(tag, "outp", 4) == 0 && length == 4) {
+            annFile.read(temp_int, 4);
+
+            int mode = DiwaConv::u8aToInt(temp_int);
+            if(mode != ACTIVATION_OUTPUT && mode != SOFTMAX_OUTPUT)
+                return MODEL_READ_ERROR;
+            this->outputMode = (DiwaOutputMode) mode;
+        }
+        else if(memcmp(tag, "norm", 4) == 0 && length == 16 * this->inputNeurons) {
+            if(this->normalization == NULL &&
+                (this->normalization = (double*) malloc(sizeof(double) * 2 * this->inputNeurons)) == NULL)
+                return MALLOC_FAILED;
+
+            for(int i = 0; i < 2 * this->inputNeurons; i++) {
+                annFile.read(temp_db, 8);
+                this->normalization[i] = DiwaConv::u8aToDouble(temp_db);
+            }
+        }
+        else annFile.seek(annFile.position() + length);
+    }
+
     return NO_ERROR;
 }
 
 DiwaError Diwa::saveToFile(File annFile) {
     const uint8_t* magic_signature = new uint8_t[4] {'d', 'i', 'w', 'a'};
-    annFile.write(magic_signature, 4);
+    writeToFile(annFile, magic_signature, 4);
 
-    annFile.write(DiwaConv::intToU8a(this->inputNeurons), 4);
-    annFile.write(DiwaConv::intToU8a(this->hiddenNeurons), 4);
-    annFile.write(DiwaConv::intToU8a(this->hiddenLayers), 4);
-    annFile.write(DiwaConv::intToU8a(this->outputNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->inputNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->hiddenNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->hiddenLayers), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->outputNeurons), 4);
 
-    annFile.write(DiwaConv::intToU8a(this->weightCount), 4);
-    annFile.write(DiwaConv::intToU8a(this->neuronCount), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->weightCount), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->neuronCount), 4);
 
     for(int i = 0; i < this->weightCount; i++)
-        annFile.write(DiwaConv::doubleToU8a(this->weights[i]), 8);
+        writeToFile(annFile, DiwaConv::doubleToU8a(this->weights[i]), 8);
+
+    writeToFile(annFile, new uint8_t[4] {'o', 'u', 't', 'p'}, 4);
+    writeToFile(annFile, DiwaConv::intToU8a(4), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->outputMode), 4);
+
+    if(this->normalization != NULL) {
+        writeToFile(annFile, new uint8_t[4] {'n', 'o', 'r', 'm'}, 4);
+        writeToFile(annFile, DiwaConv::intToU8a(16 * this->inputNeurons), 4);
+
+        for(int i = 0; i < 2 * this->inputNeurons; i++)
+            writeToFile(annFile, DiwaConv::doubleToU8a(this->normalization[i]), 8);
+    }
 
     annFile.flush();
     return NO_ERROR;
@@ -425,12 +1399,9 @@ DiwaError Diwa::loadFromFile(std::ifstream& annFile) {
             this->hiddenLayers,
             this->hiddenNeurons,
             this->outputNeurons,
-            true
+            false
         )) != NO_ERROR)
             return error;
-
-        if((error = this->initializeWeights()) != NO_ERROR)
-            return error;
     }
 
     uint8_t temp_db[9];
@@ -439,6 +1410,34 @@ DiwaError Diwa::loadFromFile(std::ifstream& annFile) {
         this->weights[i] = DiwaConv::u8aToDouble(temp_db);
     }
 
+    this->outputMode = ACTIVATION_OUTPUT;
+
+    uint8_t tag[5];
+    while(annFile.read(reinterpret_cast<char*>(tag), 4)) {
+        annFile.read(reinterpret_cast<char*>(temp_int), 4);
+        int length = DiwaConv::u8aToInt(temp_int);
+
+        if(memcmp(tag, "outp", 4) == 0 && length == 4) {
+            annFile.read(reinterpret_cast<char*>(temp_int), 4);
+
+            int mode = DiwaConv::u8aToInt(temp_int);
+            if(mode != ACTIVATION_OUTPUT && mode != SOFTMAX_OUTPUT)
+                return MODEL_READ_ERROR;
+            this->outputMode = (DiwaOutputMode) mode;
+        }
+        else if(memcmp(tag, "norm", 4) == 0 && length == 16 * this->inputNeurons) {
+            if(this->normalization == NULL &&
+                (this->normalization = (double*) malloc(sizeof(double) * 2 * this->inputNeurons)) == NULL)
+                return MALLOC_FAILED;
+
+            for(int i = 0; i < 2 * this->inputNeurons; i++) {
+                annFile.read(reinterpret_cast<char*>(temp_db), 8);
+                this->normalization[i] = DiwaConv::u8aToDouble(temp_db);
+            }
+        }
+        else annFile.seekg(length, std::ios::cur);
+    }
+
     return NO_ERROR;
 }
 
@@ -459,6 +1458,19 @@ DiwaError Diwa::saveToFile(std::ofstream& annFile) {
 
     for(int i = 0; i < this->weightCount; i++)
         writeToStream(annFile, DiwaConv::doubleToU8a(this->weights[i]), 8);
+
+    writeToStream(annFile, new uint8_t[4] {'o', 'u', 't', 'p'}, 4);
+    writeToStream(annFile, DiwaConv::intToU8a(4), 4);
+    writeToStream(annFile, DiwaConv::intToU8a(this->outputMode), 4);
+
+    if(this->normalization != NULL) {
+        writeToStream(annFile, new uint8_t[4] {'n', 'o', 'r', 'm'}, 4);
+        writeToStream(annFile, DiwaConv::intToU8a(16 * this->inputNeurons), 4);
+
+        for(int i = 0; i < 2 * this->inputNeurons; i++)
+            writeToStream(annFile, DiwaConv::doubleToU8a(this->normalization[i]), 8);
+    }
+
     return NO_ERROR;
 }
 
@@ -489,13 +1501,176 @@ double Diwa::calculateLoss(double *testInput, double *testExpectedOutput, int ep
 }
 
 void Diwa::setActivationFunction(diwa_activation activation) {
+    diwa_activation_derivative derivative = DiwaActivationFunc::derivativeOf(activation);
+    this->setActivationFunction(
+        activation,
+        derivative ? derivative : DiwaActivationFunc::sigmoidDerivative
+    );
+}
+
+void Diwa::setActivationFunction(diwa_activation activation, diwa_activation_derivative derivative) {
     this->activation = activation;
+    this->activationDerivative = derivative;
 }
 
 diwa_activation Diwa::getActivationFunction() const {
     return this->activation;
 }
 
+diwa_activation_derivative Diwa::getActivationDerivative() const {
+    return this->activationDerivative;
+}
+
+void Diwa::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+    this->seeded = true;
+}
+
+void Diwa::setWeightInitialization(DiwaInitialization initialization) {
+    this->initialization = initialization;
+}
+
+DiwaInitialization Diwa::getWeightInitialization() const {
+    return this->initialization;
+}
+
+void Diwa::setOutputMode(DiwaOutputMode mode) {
+    this->outputMode = mode;
+}
+
+DiwaOutputMode Diwa::getOutputMode() const {
+    return this->outputMode;
+}
+
+DiwaError Diwa::setLayerTrainable(int layer, bool trainable) {
+    if(layer < 0 || layer > this->hiddenLayers || this->trainableLayers == NULL)
+        return INVALID_PARAM_VALUES;
+
+    this->trainableLayers[layer] = trainable;
+    this->firstTrainable = 0;
+
+    for(int h = this->hiddenLayers; h >= 0; --h)
+        if(!this->trainableLayers[h]) {
+            this->firstTrainable = h + 1;
+            break;
+        }
+
+    return NO_ERROR;
+}
+
+void Diwa::setQuantizationAware(bool enabled) {
+    this->quantizationAware = enabled;
+}
+
+bool Diwa::isQuantizationAware() const {
+    return this->quantizationAware;
+}
+
+void Diwa::setMixedPrecision(bool enabled) {
+    this->mixedPrecision = enabled;
+}
+
+bool Diwa::isMixedPrecision() const {
+    return this->mixedPrecision;
+}
+
+DiwaError Diwa::setUpdateThreshold(double threshold) {
+    if(threshold > 0 && this->residuals == NULL && this->weightCount > 0) {
+        this->residuals = (double*) calloc(
+            this->weightCount,
+            sizeof(double)
+        );
+
+        if(this->residuals == NULL)
+            return MALLOC_FAILED;
+    }
+
+    this->updateThreshold = threshold > 0 ? threshold : 0;
+    return NO_ERROR;
+}
+
+double Diwa::getUpdateThreshold() const {
+    return this->updateThreshold;
+}
+
+bool Diwa::isLayerTrainable(int layer) const {
+    if(layer < 0 || layer > this->hiddenLayers || this->trainableLayers == NULL)
+        return false;
+
+    return this->trainableLayers[layer];
+}
+
+int Diwa::getTrainableOffset() const {
+    if(this->firstTrainable > this->hiddenLayers)
+        return this->weightCount;
+    if(this->firstTrainable == 0)
+        return 0;
+
+    return (this->inputNeurons + 1) * this->hiddenNeurons +
+        (this->firstTrainable - 1) * (this->hiddenNeurons + 1) * this->hiddenNeurons;
+}
+
+void Diwa::foldNormalization(bool fold) {
+    const int neurons = this->hiddenLayers ? this->hiddenNeurons : this->outputNeurons;
+    const double *means = this->normalization;
+    const double *deviations = means + this->inputNeurons;
+
+    double *weights = this->weights;
+    for(int j = 0; j < neurons; ++j, weights += this->inputNeurons + 1)
+        for(int k = 0; k < this->inputNeurons; ++k)
+            if(fold) {
+                weights[k + 1] /= deviations[k];
+                weights[0] += weights[k + 1] * means[k];
+            }
+            else {
+                weights[0] -= weights[k + 1] * means[k];
+                weights[k + 1] *= deviations[k];
+            }
+
+    this->reducedStale = true;
+}
+
+DiwaError Diwa::setInputNormalization(const double *means, const double *deviations) {
+    if(this->weightCount <= 0 || (means == NULL) != (deviations == NULL))
+        return INVALID_PARAM_VALUES;
+
+    if(deviations != NULL)
+        for(int i = 0; i < this->inputNeurons; ++i)
+            if(!(fabs(deviations[i]) > 0 && fabs(deviations[i]) < HUGE_VAL))
+                return INVALID_PARAM_VALUES;
+
+    if(this->normalization != NULL)
+        this->foldNormalization(false);
+    else if(means != NULL &&
+        (this->normalization = (double*) malloc(sizeof(double) * 2 * this->inputNeurons)) == NULL)
+        return MALLOC_FAILED;
+
+    if(means == NULL) {
+        free(this->normalization);
+        this->normalization = NULL;
+
+        return NO_ERROR;
+    }
+
+    memcpy(this->normalization, means, sizeof(double) * this->inputNeurons);
+    memcpy(this->normalization + this->inputNeurons, deviations, sizeof(double) * this->inputNeurons);
+
+    this->foldNormalization(true);
+    return NO_ERROR;
+}
+
+bool Diwa::getInputNormalization(double *means, double *deviations) const {
+    if(this->normalization == NULL)
+        return false;
+
+    if(means != NULL)
+        memcpy(means, this->normalization, sizeof(double) * this->inputNeurons);
+    if(deviations != NULL)
+        memcpy(deviations, this->normalization + this->inputNeurons, sizeof(double) * this->inputNeurons);
+
+    return true;
+}
+
 int Diwa::recommendedHiddenNeuronCount() {
     if(this->inputNeurons <= 0 || this->outputNeurons <= 0)
         return -1;
@@ -540,10 +1715,74 @@ int Diwa::getNeuronCount() const {
     return this->neuronCount;
 }
 
+size_t Diwa::getFootprint(
+    int inputNeurons,
+    int hiddenLayers,
+    int hiddenNeurons,
+    int outputNeurons,
+    bool training
+) {
+    if(inputNeurons <= 0 || hiddenLayers < 0 ||
+        (hiddenLayers > 0 && hiddenNeurons <= 0) ||
+        outputNeurons <= 0)
+        return 0;
+
+    size_t weightCount, neuronCount;
+    countTopology(
+        inputNeurons, hiddenLayers,
+        hiddenNeurons, outputNeurons,
+        &weightCount, &neuronCount
+    );
+
+    size_t footprint = sizeof(double) * (weightCount + 2 * neuronCount) +
+        sizeof(bool) * (hiddenLayers + 1);
+    if(training)
+        footprint += sizeof(double) * weightCount;
+
+    return footprint;
+}
+
+size_t Diwa::getFootprint(bool training) const {
+    if(this->weightCount <= 0)
+        return 0;
+
+    size_t footprint = Diwa::getFootprint(
+        this->inputNeurons,
+        this->hiddenLayers,
+        this->hiddenNeurons,
+        this->outputNeurons,
+        training
+    );
+
+    if(this->normalization != NULL)
+        footprint += sizeof(double) * 2 * this->inputNeurons;
+
+    if(training) {
+        if(this->updateThreshold > 0)
+            footprint += sizeof(double) * this->weightCount;
+        if(this->mixedPrecision)
+            footprint += sizeof(float) * (this->weightCount + 2 * this->neuronCount);
+        if(this->quantizationAware)
+            footprint += sizeof(double) * this->weightCount;
+    }
+
+    return footprint;
+}
+
 void Diwa::getWeights(double* weights) {
-    weights = this->weights;
+    memcpy(weights, this->weights, sizeof(double) * this->weightCount);
+}
+
+void Diwa::setWeights(const double* weights) {
+    memcpy(this->weights, weights, sizeof(double) * this->weightCount);
+    this->reducedStale = true;
 }
 
 void Diwa::getOutputs(double* outputs) {
-    outputs = this->outputs;
+    memcpy(
+        outputs,
+        this->outputs + this->inputNeurons +
+            this->hiddenNeurons * this->hiddenLayers,
+        sizeof(double) * this->outputNeurons
+    );
 }
@@ -58,9 +58,24 @@
 #   include <math.h>
 #endif
 
+#if (defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)) && \
+    !defined(ARDUINO) && \
+    (!defined(__EMSCRIPTEN__) || \
+    defined(__EMSCRIPTEN_PTHREADS__))
+#   define DIWA_THREADS /**< Defined on the platforms providing std::thread */
+#endif
+
 #include <diwa_activations.h>
+#include <diwa_random.h>
+#include <stddef.h>
 #include <stdint.h>
 
+class DiwaDataset;
+class DiwaMetrics;
+
 /**
  * @enum DiwaError
  * @brief Enumeration representing various error codes
@@ -75,8 +90,32 @@ typedef enum {
     INVALID_MAGIC_NUMBER,   /**< Invalid magic number */
     STREAM_NOT_OPEN,        /**< Stream not open */
     MALLOC_FAILED,          /**< Memory allocation failed */
+    TRAINING_INTERRUPTED,   /**< Training was stopped by a checkpoint callback */
 } DiwaError;
 
+/**
+ * @enum DiwaOutputMode
+ * @brief Enumeration representing how the output layer
+ *        of the neural network computes its values and
+ *        which loss is minimized during training.
+ */
+typedef enum {
+    ACTIVATION_OUTPUT,      /**< Output layer uses the activation function with squared-error loss */
+    SOFTMAX_OUTPUT,         /**< Output layer uses softmax with cross-entropy loss */
+} DiwaOutputMode;
+
+/**
+ * @enum DiwaInitialization
+ * @brief Enumeration representing the schemes used to
+ *        randomize the weights of the neural network.
+ */
+typedef enum {
+    UNIFORM_INITIALIZATION, /**< Uniformly distributed within [-0.5, 0.5] */
+    XAVIER_INITIALIZATION,  /**< Uniformly distributed within ±sqrt(6 / (fan-in + fan-out)), zero biases */
+    HE_INITIALIZATION,      /**< Normally distributed with deviation sqrt(2 / fan-in), zero biases */
+    LECUN_INITIALIZATION,   /**< Normally distributed with deviation sqrt(1 / fan-in), zero biases */
+} DiwaInitialization;
+
 /**
  * 
  * @class Diwa
@@ -96,6 +135,13 @@ typedef enum {
  * 
  */
 class Diwa final {
+    friend class DiwaEvolution;
+    friend class DiwaFixed;
+    friend class DiwaLBFGS;
+    friend class DiwaOnline;
+    friend class DiwaQuantized;
+    friend class DiwaTrainer;
+
 private:
     int inputNeurons;   /**< Number of input neurons */
     int hiddenNeurons;  /**< Number of neurons in each hidden layer */
@@ -110,6 +156,27 @@ private:
     double *deltas;      /**< Array to store delta values during training */
 
     diwa_activation activation; /**< Activation function to be used on inference */
+    diwa_activation_derivative activationDerivative; /**< Derivative of the activation function used on training */
+    DiwaOutputMode outputMode;  /**< Output layer mode and its corresponding loss function */
+
+    DiwaRandom randomizer;              /**< Pseudo-random number generator of this instance */
+    DiwaInitialization initialization;  /**< Scheme used to randomize the weights */
+    bool seeded;                        /**< Whether the generator was explicitly seeded */
+
+    bool *trainableLayers;  /**< Trainable flag of every hidden layer followed by the output layer */
+    int firstTrainable;     /**< Lowest layer reached by backpropagation, above the highest frozen layer */
+
+    double *residuals;      /**< Accumulated updates of the weights whose updates were skipped */
+    double updateThreshold; /**< Magnitude below which the update of a weight is skipped */
+
+    bool mixedPrecision;    /**< Whether train() runs the forward and backward passes in single precision */
+    bool reducedStale;      /**< Whether the weights changed since their single precision copy was made */
+    float *reduced;         /**< Single precision weights, followed by the outputs and the deltas */
+
+    bool quantizationAware; /**< Whether train() runs the forward and backward passes on int8 weights */
+    double *quantized;      /**< Weights rounded to their int8 levels by the last call to train() */
+
+    double *normalization;  /**< Means followed by standard deviations of the inputs folded into the first layer, or NULL */
 
     /**
      * @brief Randomizes the weights in the neural network.
@@ -117,7 +184,9 @@ private:
      * This function randomizes the weights in the neural network to initialize them 
      * with random values. It is typically used during the initialization of the 
      * neural network to ensure that the weights start with diverse values, which 
-     * aids in learning and prevents convergence to local minima.
+     * aids in learning and prevents convergence to local minima. The values are drawn
+     * from the generator of this instance, scaled by the fan-in and fan-out of each
+     * layer according to the selected DiwaInitialization scheme.
      */
     void randomizeWeights();
 
@@ -125,8 +194,9 @@ private:
      * @brief Initializes memory for neural network weights.
      *
      * This function allocates memory for the weights of the neural network. It 
-     * initializes the memory space required to store the weights, which is determined 
-     * based on the architecture and parameters of the neural network. If memory allocation 
+     * releases any previous allocation and allocates a single block of exactly
+     * `getWeightCount() + 2 * getNeuronCount()` doubles, holding the weights followed by
+     * the outputs and the deltas of the neurons. If memory allocation 
      * fails, it returns an error code indicating the failure, allowing the calling code 
      * to handle the error gracefully.
      *
@@ -135,6 +205,148 @@ private:
      */
     DiwaError initializeWeights();
 
+    /**
+     * @brief Gets the index of the first weight that training may write.
+     *
+     * The weights below this index belong to the highest frozen layer and the layers
+     * below it, which are never updated since backpropagation stops above them.
+     *
+     * @return The index of the first trainable weight, or `getWeightCount()` if the
+     *         output layer is frozen.
+     */
+    int getTrainableOffset() const;
+
+    /**
+     * @brief Propagates the given inputs forward through every layer of the network.
+     *
+     * This function computes the outputs of every neuron, layer by layer. When used
+     * for training, it also stores the activation derivative of every non-input neuron
+     * in the deltas array, so the backpropagation can scale the errors with the derivative
+     * of the activation function without evaluating it again.
+     *
+     * @param inputNeurons Array of input values for the neural network.
+     * @param training Flag indicating whether to store activation derivatives for training.
+     * @return Pointer to the output values of the output layer.
+     */
+    double* forwardPass(double *inputNeurons, bool training);
+
+    /**
+     * @brief Propagates the given inputs forward through every layer using the given buffers.
+     *
+     * This function does not modify the state of the network, so it can evaluate several
+     * weight vectors laid out like the network's weights concurrently, as long as each
+     * caller provides its own outputs (and derivatives) buffer. It is instantiated for
+     * double, and for float to run the mixed precision training. The input values may be
+     * of another type, in which case they are converted while being loaded into the input
+     * neurons.
+     *
+     * @param weights Array of weights laid out like the network's weights.
+     * @param outputs Array of at least `getNeuronCount()` elements receiving the neuron outputs.
+     * @param inputNeurons Array of input values for the neural network.
+     * @param derivatives Array receiving the activation derivatives of every non-input neuron, or NULL.
+     * @param logits Flag indicating whether to skip the softmax normalization with SOFTMAX_OUTPUT.
+     * @return Pointer to the output values of the output layer within the outputs array.
+     */
+    template<typename T, typename I = T>
+    T* forward(
+        const T *weights,
+        T *outputs,
+        const I *inputNeurons,
+        T *derivatives,
+        bool logits
+    ) const;
+
+    /**
+     * @brief Computes the deltas of every non-input neuron for the given targets.
+     *
+     * This function must follow a training forward pass. It turns the activation
+     * derivatives stored by the forward pass into the error terms of each neuron,
+     * starting from the output layer and going backwards.
+     *
+     * The deltas of the layers below the highest frozen layer are left untouched.
+     *
+     * @param weights Array of weights used by the forward pass.
+     * @param outputs Array of neuron outputs computed by the forward pass.
+     * @param deltas Array of activation derivatives stored by the forward pass, receiving the deltas.
+     * @param outputNeurons Array of target output values.
+     * @return The loss of the sample, according to the output mode.
+     */
+    template<typename T>
+    double backpropagate(
+        const T *weights,
+        const T *outputs,
+        T *deltas,
+        const double *outputNeurons
+    ) const;
+
+    /**
+     * @brief Adds the current deltas, scaled by the inputs of each neuron, to a weight array.
+     *
+     * With the network's weights and a positive learning rate, this performs a gradient
+     * descent step. With a separate array and a negative rate, it accumulates the gradient.
+     * Only the layers reached by backpropagation are updated.
+     *
+     * When residuals are given, the update of each weight is added to its residual, and
+     * the weight is only updated once the magnitude of the sum reaches the update
+     * threshold; otherwise the sum is kept in the residual for the next call.
+     *
+     * @param weights Array laid out like the network's weights receiving the update.
+     * @param outputs Array of neuron outputs computed by the forward pass.
+     * @param deltas Array of deltas computed by the backpropagation.
+     * @param learningRate Factor applied to every update.
+     * @param residuals Array of one residual per weight, or NULL to update every weight.
+     * @param reduced Single precision copy of the weights kept in sync with every update, or NULL.
+     */
+    template<typename T>
+    void applyDeltas(
+        double *weights,
+        const T *outputs,
+        const T *deltas,
+        double learningRate,
+        double *residuals,
+        float *reduced
+    ) const;
+
+    /**
+     * @brief Copies the weights into their single precision copy, allocating it if needed.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError synchronizeReduced();
+
+    /**
+     * @brief Computes the int8 quantization scale of a layer.
+     *
+     * The scale maps the weight of largest magnitude in the layer, bias included,
+     * to the level 127, so no weight of the layer is clipped.
+     *
+     * @param layer Index of the layer, the output layer having the index `hiddenLayers`.
+     * @param offset Pointer receiving the index of the first weight of the layer, or NULL.
+     * @param count Pointer receiving the number of weights of the layer, or NULL.
+     * @return The scale of the layer, or 0 if all of its weights are zero.
+     */
+    double quantizationScale(int layer, int *offset, int *count) const;
+
+    /**
+     * @brief Rounds every weight to the nearest level of its layer's int8 quantization.
+     *
+     * The rounded weights are written into the quantized array, which is allocated if needed.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError fakeQuantize();
+
+    /**
+     * @brief Folds the input normalization into the first layer, or unfolds it.
+     *
+     * Folding divides the weights of every first-layer neuron by the standard
+     * deviations of their inputs and adds the resulting mean offsets to the biases,
+     * so that the layer computes on raw inputs what it computed on standardized ones.
+     *
+     * @param fold True to fold the normalization in, false to take it back out.
+     */
+    void foldNormalization(bool fold);
+
     /**
      * @brief Tests the inference of the neural network for a given input.
      *
@@ -178,6 +390,7 @@ public:
      * @param hiddenNeurons Number of neurons in each hidden layer.
      * @param outputNeurons Number of output neurons in the neural network.
      * @param randomizeWeights Flag indicating whether to randomize weights in the network (default is true).
+     *        The weights are allocated either way, but left uninitialized when false.
      * 
      * @return DiwaError indicating the initialization status.
      */
@@ -203,25 +416,182 @@ public:
      */
     double* inference(double *inputs);
 
+    /**
+     * 
+     * @brief Perform inference on single precision inputs.
+     *
+     * The inputs are converted to double precision while
+     * being loaded into the input neurons.
+     *
+     * @param inputs Array of input values for the neural network.
+     * @return Array of output values after inference.
+     * 
+     */
+    double* inference(const float *inputs);
+
+    /**
+     * 
+     * @brief Perform inference on raw signed 16-bit inputs.
+     *
+     * The inputs, e.g. raw sensor readings, are converted while
+     * being loaded into the input neurons. Combined with an input
+     * normalization, the network computes on standardized values
+     * without any per-call preprocessing.
+     *
+     * @param inputs Array of input values for the neural network.
+     * @return Array of output values after inference.
+     * 
+     */
+    double* inference(const int16_t *inputs);
+
+    /**
+     * 
+     * @brief Perform inference on raw unsigned 16-bit inputs.
+     *
+     * The inputs, e.g. ADC readings, are converted while being
+     * loaded into the input neurons.
+     *
+     * @param inputs Array of input values for the neural network.
+     * @return Array of output values after inference.
+     * 
+     */
+    double* inference(const uint16_t *inputs);
+
+    /**
+     * 
+     * @brief Perform inference on raw 8-bit inputs.
+     *
+     * The inputs, e.g. pixel intensities, are converted while
+     * being loaded into the input neurons.
+     *
+     * @param inputs Array of input values for the neural network.
+     * @return Array of output values after inference.
+     * 
+     */
+    double* inference(const uint8_t *inputs);
+
+    /**
+     * 
+     * @brief Perform inference and return the index of the highest output.
+     *
+     * This method is a serving path for classifiers. It computes
+     * the network for the given inputs and returns the index of
+     * the output neuron with the highest value. When the output
+     * mode is SOFTMAX_OUTPUT, the softmax normalization is skipped
+     * entirely, since it does not change which output is the largest.
+     *
+     * @param inputs Array of input values for the neural network.
+     * @return Index of the output neuron with the highest value.
+     * 
+     */
+    int classify(double *inputs);
+
     /**
      * 
      * @brief Train the neural network using backpropagation.
      *
      * This method facilitates the training of the neural
      * network by adjusting its weights based on the provided
-     * input and target output values.
+     * input and target output values. The squared-error loss is
+     * minimized with ACTIVATION_OUTPUT, and the cross-entropy loss
+     * with SOFTMAX_OUTPUT, for which the target output values are
+     * expected to be one-hot encoded (or a probability distribution).
      *
      * @param learningRate Learning rate for the training process.
      * @param inputNeurons Array of input values for training.
      * @param outputNeurons Array of target output values for training.
      * 
+     * @return The loss of the sample before the weights were updated;
+     *         half the sum of squared errors with ACTIVATION_OUTPUT, or
+     *         the cross-entropy with SOFTMAX_OUTPUT.
+     * 
      */
-    void train(
+    double train(
         double learningRate,
         double *inputNeurons,
         double *outputNeurons
     );
 
+    /**
+     * 
+     * @brief Compute the exact gradient of the loss over a dataset.
+     *
+     * This method computes the mean loss over all samples of the
+     * dataset and its gradient with respect to every weight, without
+     * modifying the weights. It is the building block for full-batch
+     * trainers such as DiwaLBFGS.
+     *
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @param gradient Array of at least `getWeightCount()` elements receiving the gradient.
+     * 
+     * @return The mean loss over the dataset.
+     * 
+     */
+    double calculateGradient(
+        double *inputs,
+        double *targets,
+        int samples,
+        double *gradient
+    );
+
+    /**
+     * 
+     * @brief Train the neural network over a dataset.
+     *
+     * This method shuffles the dataset at the beginning of every epoch, then
+     * trains the network on its samples batch by batch. With a batch size of
+     * 1, every sample is trained on with train(). With larger batch sizes, the
+     * updates of the samples of a batch are averaged and applied once per
+     * batch, which ignores the update threshold, mixed precision and
+     * quantization-aware training settings. On desktop platforms, the
+     * samples of a batch can be split across several threads, each one
+     * accumulating the updates of its share of the batch.
+     *
+     * @param learningRate Learning rate for the training process.
+     * @param dataset The dataset to train on.
+     * @param epochs Number of passes over the dataset.
+     * @param batchSize Number of samples per batch.
+     * @param threads Number of threads sharing each batch, or 0 for one per
+     *        hardware thread. Ignored with a batch size of 1 and on Arduino.
+     * 
+     * @return DiwaError indicating the training status.
+     * 
+     */
+    DiwaError fit(
+        double learningRate,
+        DiwaDataset& dataset,
+        int epochs,
+        int batchSize,
+        int threads = 1
+    );
+
+    /**
+     * 
+     * @brief Evaluate the neural network on a whole dataset.
+     *
+     * This method runs the inference of every sample of the
+     * dataset once, and computes the mean squared error, the
+     * cross-entropy, the accuracy and the confusion matrix of
+     * the network. On desktop platforms, the samples are split
+     * across several threads, each one with its own outputs
+     * buffer, so the network itself is left untouched.
+     *
+     * @param dataset The dataset to evaluate the network on.
+     * @param metrics The metrics receiving the results.
+     * @param threads Number of threads, or 0 for one per hardware
+     *        thread. Ignored on Arduino.
+     * 
+     * @return DiwaError indicating the evaluation status.
+     * 
+     */
+    DiwaError evaluate(
+        const DiwaDataset& dataset,
+        DiwaMetrics& metrics,
+        int threads = 0
+    ) const;
+
     #ifdef ARDUINO
 
     /**
@@ -317,6 +687,7 @@ public:
      * @param epoch Total number of test samples in the test data.
      * 
      * @return The accuracy of the neural network on the test data as a percentage.
+     * @see Diwa::evaluate() to evaluate the network on a whole dataset.
      */
     double calculateAccuracy(double *testInput, double *testExpectedOutput, int epoch);
 
@@ -343,11 +714,28 @@ public:
      * functions can be used depending on the nature of the problem being solved and the characteristics of
      * the dataset. Common activation functions include sigmoid, ReLU, and tanh.
      *
+     * The derivative used during training is looked up from the built-in activation functions
+     * of DiwaActivationFunc. Custom activation functions without a known derivative fall back
+     * to the sigmoid derivative; use the overload accepting a derivative to train them correctly.
+     *
      * @param activation The activation function to be set for the neural network.
      * @see Diwa::getActivationFunction()
      */
     void setActivationFunction(diwa_activation activation);
 
+    /**
+     * @brief Sets the activation function and its derivative for the neural network.
+     *
+     * This method sets a custom activation function together with the derivative used by the
+     * backpropagation in Diwa::train(). The derivative receives the weighted input of a neuron
+     * and the output of the activation function for that input.
+     *
+     * @param activation The activation function to be set for the neural network.
+     * @param derivative The derivative of the given activation function.
+     * @see Diwa::getActivationDerivative()
+     */
+    void setActivationFunction(diwa_activation activation, diwa_activation_derivative derivative);
+
     /**
      * @brief Retrieves the current activation function used by the neural network.
      *
@@ -362,6 +750,203 @@ public:
      */
     diwa_activation getActivationFunction() const;
 
+    /**
+     * @brief Retrieves the derivative of the current activation function.
+     *
+     * This method returns the derivative paired with the activation function currently set
+     * for the neural network, which is used by the backpropagation during training.
+     *
+     * @return The derivative of the activation function currently set for the neural network.
+     * @see Diwa::setActivationFunction()
+     */
+    diwa_activation_derivative getActivationDerivative() const;
+
+    /**
+     * @brief Seeds the pseudo-random number generator of the neural network.
+     *
+     * Every Diwa instance owns its own generator, so instances can be initialized from
+     * different threads without sharing state. Seeding two instances with the same value
+     * before calling initialize() gives them identical weights. Without an explicit seed,
+     * the generator is seeded when the network is initialized: from the hardware random
+     * number generator on ESP32, from `random()` on other Arduino boards, and from
+     * `std::random_device` on desktop platforms, which is safe to use from several threads
+     * at once. Unseeded desktop runs therefore produce different weights on every run;
+     * call setSeed() before initialize() when the results need to be reproducible.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Sets the scheme used to randomize the weights.
+     *
+     * The scheme takes effect on the next call to initialize(). Xavier initialization suits
+     * sigmoid and tanh activations, while He initialization suits ReLU and leaky ReLU.
+     *
+     * @param initialization The weight initialization scheme.
+     * @see Diwa::getWeightInitialization()
+     */
+    void setWeightInitialization(DiwaInitialization initialization);
+
+    /**
+     * @brief Retrieves the scheme used to randomize the weights.
+     *
+     * @return The weight initialization scheme.
+     * @see Diwa::setWeightInitialization()
+     */
+    DiwaInitialization getWeightInitialization() const;
+
+    /**
+     * @brief Sets the output mode of the neural network.
+     *
+     * With ACTIVATION_OUTPUT (the default), the output layer uses the activation function of the
+     * network and training minimizes the squared error. With SOFTMAX_OUTPUT, the output layer
+     * produces a numerically stable softmax over its weighted inputs, and training minimizes the
+     * cross-entropy loss, whose gradient simplifies to the difference of the target and the output.
+     * The output mode is saved into and loaded from model files.
+     *
+     * @param mode The output mode to be set for the neural network.
+     * @see Diwa::getOutputMode()
+     */
+    void setOutputMode(DiwaOutputMode mode);
+
+    /**
+     * @brief Retrieves the current output mode of the neural network.
+     *
+     * @return The output mode currently set for the neural network.
+     * @see Diwa::setOutputMode()
+     */
+    DiwaOutputMode getOutputMode() const;
+
+    /**
+     * @brief Sets whether a layer of the neural network is trained.
+     *
+     * Layers are indexed from the first hidden layer, and the output layer has the index
+     * `getHiddenLayers()`. Backpropagation in train() and calculateGradient() stops at
+     * the highest frozen layer, so the layers below it are not trained either, and the
+     * weights of these layers are never written. Every layer is trainable after initialization.
+     *
+     * @param layer Index of the layer.
+     * @param trainable Whether the weights of the layer are updated by training.
+     * @return DiwaError::INVALID_PARAM_VALUES if the layer does not exist, otherwise DiwaError::NO_ERROR.
+     * @see Diwa::isLayerTrainable()
+     */
+    DiwaError setLayerTrainable(int layer, bool trainable);
+
+    /**
+     * @brief Enables or disables quantization-aware training.
+     *
+     * In quantization-aware training, train() rounds the weights of every layer to the 255
+     * levels of a symmetric int8 quantization whose per-layer scale is calibrated from the
+     * current weights, and runs the forward and backward passes on the rounded weights. The
+     * resulting update is applied to the unrounded weights, as if the rounding were the
+     * identity (straight-through estimator), so the network learns weights which keep their
+     * accuracy once exported with DiwaQuantized. Mixed precision is not used in this mode.
+     *
+     * @param enabled True to train with fake-quantized weights, false to train normally (default).
+     * @see Diwa::isQuantizationAware()
+     */
+    void setQuantizationAware(bool enabled);
+
+    /**
+     * @brief Retrieves whether quantization-aware training is enabled.
+     *
+     * @return True if train() runs on fake-quantized weights, false otherwise.
+     * @see Diwa::setQuantizationAware()
+     */
+    bool isQuantizationAware() const;
+
+    /**
+     * @brief Sets the threshold below which the update of a weight is skipped.
+     *
+     * With a positive threshold, train() only rewrites the weights whose update, the delta
+     * of their neuron scaled by the learning rate and by their input, reaches the threshold
+     * in magnitude. The skipped updates accumulate in a per-weight residual, allocated by
+     * this method or by initialize(), which is added to the next update of the weight, so
+     * no update is ever lost; it is only applied later.
+     *
+     * Every update is still computed and added to its residual, so this does not make
+     * train() faster. It reduces the number of writes to the weights, at the cost of one
+     * residual per weight, `8 * getWeightCount()` bytes.
+     *
+     * Setting the threshold back to 0 flushes every residual on the next call to train().
+     *
+     * @param threshold The update threshold (default is 0, which updates every weight).
+     * @return DiwaError indicating whether the residuals could be allocated.
+     * @see Diwa::getUpdateThreshold()
+     */
+    DiwaError setUpdateThreshold(double threshold);
+
+    /**
+     * @brief Retrieves the threshold below which the update of a weight is skipped.
+     *
+     * @return The update threshold of the neural network.
+     * @see Diwa::setUpdateThreshold()
+     */
+    double getUpdateThreshold() const;
+
+    /**
+     * @brief Enables or disables mixed precision training.
+     *
+     * In mixed precision, train() runs the forward and backward passes in single precision
+     * on a float copy of the weights, while the updates are still applied to the double
+     * precision weights and then copied into the float copy. This halves the memory traffic
+     * of both passes, which run the built-in activation functions in single precision and
+     * keep independent partial sums so that they vectorize without reordering floating
+     * point additions. Inference, calculateGradient() and model files keep using the double
+     * precision weights.
+     *
+     * @param enabled True to train in mixed precision, false to train in double precision (default).
+     * @see Diwa::isMixedPrecision()
+     */
+    void setMixedPrecision(bool enabled);
+
+    /**
+     * @brief Retrieves whether mixed precision training is enabled.
+     *
+     * @return True if train() runs in mixed precision, false otherwise.
+     * @see Diwa::setMixedPrecision()
+     */
+    bool isMixedPrecision() const;
+
+    /**
+     * @brief Retrieves whether a layer of the neural network is flagged as trainable.
+     *
+     * @param layer Index of the layer, the output layer having the index `getHiddenLayers()`.
+     * @return The trainable flag of the layer, or false if the layer does not exist.
+     * @see Diwa::setLayerTrainable()
+     */
+    bool isLayerTrainable(int layer) const;
+
+    /**
+     * @brief Sets the standardization of the inputs, `(x - mean) / deviation`.
+     *
+     * The normalization is folded into the weights and biases of the first layer, so the
+     * network then takes raw inputs and computes exactly what it computed on standardized
+     * inputs, at no cost per inference. A network trained on standardized samples can thus
+     * be served raw readings, e.g. through the integer inference() overloads.
+     *
+     * Model files store the folded weights along with the normalization, so that loading
+     * restores both without folding anything again. Training afterwards updates the folded
+     * weights from raw inputs.
+     *
+     * @param means Mean of every input, or NULL to remove the normalization.
+     * @param deviations Nonzero standard deviation of every input, or NULL to remove the normalization.
+     * @return DiwaError indicating the status of the operation.
+     * @see Diwa::getInputNormalization()
+     */
+    DiwaError setInputNormalization(const double *means, const double *deviations);
+
+    /**
+     * @brief Retrieves the standardization of the inputs folded into the first layer.
+     *
+     * @param means Array receiving the mean of every input, or NULL.
+     * @param deviations Array receiving the standard deviation of every input, or NULL.
+     * @return True if the network has an input normalization, false otherwise.
+     * @see Diwa::setInputNormalization()
+     */
+    bool getInputNormalization(double *means, double *deviations) const;
+
     /**
      * @brief Calculates the recommended number of hidden neurons based on the input and output neurons.
      *
@@ -456,6 +1041,45 @@ public:
      */
     int getNeuronCount() const;
 
+    /**
+     * @brief Get the heap memory needed by a network topology.
+     *
+     * This function computes the bytes a Diwa instance of the given topology allocates,
+     * without allocating anything, so that a topology can be checked against the memory
+     * of the target before initializing it. The inference footprint covers the weights,
+     * the outputs and deltas of the neurons, and the trainable layer flags. The training
+     * footprint adds the step buffer of a single-threaded fit(); every additional thread
+     * of fit() needs another `getWeightCount() + 2 * getNeuronCount()` doubles.
+     *
+     * @param inputNeurons Number of input neurons in the neural network.
+     * @param hiddenLayers Number of hidden layers in the neural network.
+     * @param hiddenNeurons Number of neurons in each hidden layer.
+     * @param outputNeurons Number of output neurons in the neural network.
+     * @param training Whether to include the memory needed for training.
+     *
+     * @return The footprint in bytes, or 0 if the topology is invalid.
+     */
+    static size_t getFootprint(
+        int inputNeurons,
+        int hiddenLayers,
+        int hiddenNeurons,
+        int outputNeurons,
+        bool training = false
+    );
+
+    /**
+     * @brief Get the heap memory needed by this neural network.
+     *
+     * In addition to the footprint of the topology, this function accounts for the
+     * input normalization, and when training, for the residuals of sparse updates, the
+     * single-precision copy of mixed precision training and the quantized copy of
+     * quantization-aware training, as currently configured.
+     *
+     * @param training Whether to include the memory needed for training.
+     * @return The footprint in bytes, or 0 if the network is not initialized.
+     */
+    size_t getFootprint(bool training = false) const;
+
     /**
      * @brief Retrieve the weights of the neural network.
      *
@@ -468,6 +1092,16 @@ public:
      */
     void getWeights(double* weights);
 
+    /**
+     * @brief Replace the weights of the neural network.
+     *
+     * This function copies the given weights into the neural network,
+     * e.g. to restore weights previously retrieved with `getWeights()`.
+     *
+     * @param weights Pointer to an array holding at least `getWeightCount()` weights.
+     */
+    void setWeights(const double* weights);
+
     /**
      * @brief Retrieve the outputs of the neural network.
      *
@@ -31,10 +31,10 @@
  * based on its input. They introduce non-linearity to the network, allowing it to learn complex patterns
  * and relationships in the data.
  *
- * The DiwaActivationFunc class contains static methods for popular activation functions, including sigmoid
- * and gaussian functions. These activation functions are used to introduce non-linearity and regulate
- * the output values of neurons in the neural network. They transform the input values into output values
- * suitable for the task at hand, such as classification or regression.
+ * The DiwaActivationFunc class contains static methods for popular activation functions, including sigmoid,
+ * gaussian, radial basis, ReLU, leaky ReLU, hard-sigmoid and tanh functions. Each activation function is
+ * paired with its derivative, which is used by the backpropagation in Diwa::train() to compute the
+ * gradient of the selected activation instead of assuming a sigmoid.
  *
  * @note Activation functions are an essential component of neural networks and significantly influence
  *       the network's learning dynamics and performance. The choice of activation function depends on
@@ -46,9 +46,11 @@
 
 #include <diwa_conv.h>
 #include <math.h>
+#include <stddef.h>
 
 #define DIWA_ACTFUNC_LOWER_BOUND -30.0f /**< Lower bound for input values to prevent overflow. */
 #define DIWA_ACTFUNC_UPPER_BOUND 30.0f  /**< Upper bound for input values to prevent overflow. */
+#define DIWA_ACTFUNC_LEAKY_SLOPE 0.01   /**< Default negative slope of the leaky ReLU function. */
 
 /**
  * @brief Typedef for activation function pointer.
@@ -58,17 +60,29 @@
  */
 typedef double (*diwa_activation)(double);
 
+/**
+ * @brief Typedef for activation derivative function pointer.
+ *
+ * This typedef defines the signature for the derivatives of activation functions. A derivative
+ * receives both the weighted input `x` of the neuron and the already computed activation output
+ * `y = f(x)`, so that cheap derivatives (e.g. `y * (1 - y)` for sigmoid) can reuse the output
+ * while derivatives that depend on the input (e.g. gaussian) can still be evaluated exactly.
+ */
+typedef double (*diwa_activation_derivative)(double x, double y);
+
 /**
  * @brief Class containing static methods for common activation functions.
  *
  * The DiwaActivationFunc class provides a set of static methods for common activation functions
  * used in neural networks. These activation functions transform the input value to produce the
- * output value of a neuron. Supported activation functions include sigmoid and gaussian functions.
+ * output value of a neuron. Supported activation functions include sigmoid, gaussian, radial basis,
+ * ReLU, leaky ReLU, hard-sigmoid and tanh functions, each with a matching derivative.
  */
 class DiwaActivationFunc final {
 private:
     static inline double region = 2.0f; /**< The region parameter for the radial basis function. */
     static inline double center = 0.0f; /**< The center parameter for the radial basis function. */
+    static inline double slope = DIWA_ACTFUNC_LEAKY_SLOPE; /**< The negative slope of the leaky ReLU function. */
 
 public:
     /**
@@ -86,6 +100,28 @@ public:
         DiwaActivationFunc::region = 2 * pow(width, 2);
     }
 
+    /**
+     * @brief Initializes the negative slope of the leaky ReLU function.
+     *
+     * The leaky ReLU function passes positive inputs unchanged and scales negative inputs by this
+     * slope, which keeps a small gradient flowing through inactive neurons. The default slope is
+     * DIWA_ACTFUNC_LEAKY_SLOPE.
+     *
+     * @param slope The factor applied to negative inputs of the leaky ReLU function.
+     */
+    static inline void initializeLeakyReLU(double slope) {
+        DiwaActivationFunc::slope = slope;
+    }
+
+    /**
+     * @brief Gets the negative slope of the leaky ReLU function.
+     *
+     * @return The slope set with DiwaActivationFunc::initializeLeakyReLU(), or DIWA_ACTFUNC_LEAKY_SLOPE.
+     */
+    static inline double getLeakyReLUSlope() {
+        return DiwaActivationFunc::slope;
+    }
+
     /**
      * @brief Computes the output of the radial basis function.
      *
@@ -103,6 +139,18 @@ public:
         );
     }
 
+    /**
+     * @brief Derivative of the radial basis function.
+     *
+     * @param x The weighted input of the neuron.
+     * @param y The output of the radial basis function for `x`.
+     * @return The derivative of the radial basis function at `x`.
+     */
+    static inline double radialBasisDerivative(double x, double y) {
+        return -2.0 * (x - DiwaActivationFunc::center) /
+            DiwaActivationFunc::region * y;
+    }
+
     /**
      * @brief Sigmoid activation function.
      *
@@ -122,6 +170,18 @@ public:
         return 1.0 / (1.0 + exp(-x));
     }
 
+    /**
+     * @brief Derivative of the sigmoid activation function.
+     *
+     * @param x The weighted input of the neuron (unused).
+     * @param y The output of the sigmoid function for `x`.
+     * @return The derivative of the sigmoid function, `y * (1 - y)`.
+     */
+    static inline double sigmoidDerivative(double x, double y) {
+        (void) x;
+        return y * (1.0 - y);
+    }
+
     /**
      * @brief Gaussian activation function.
      *
@@ -140,6 +200,163 @@ public:
 
         return 1.0 / exp(x * x);
     }
+
+    /**
+     * @brief Derivative of the gaussian activation function.
+     *
+     * The derivative is zero outside of the clamped input range, matching the constant
+     * outputs returned by DiwaActivationFunc::gaussian() there.
+     *
+     * @param x The weighted input of the neuron.
+     * @param y The output of the gaussian function for `x`.
+     * @return The derivative of the gaussian function at `x`.
+     */
+    static inline double gaussianDerivative(double x, double y) {
+        if(x < DIWA_ACTFUNC_LOWER_BOUND || x > DIWA_ACTFUNC_UPPER_BOUND)
+            return 0;
+
+        return -2.0 * x * y;
+    }
+
+    /**
+     * @brief Rectified linear unit (ReLU) activation function.
+     *
+     * The ReLU function returns the input value when it is positive and zero otherwise.
+     * It does not involve any transcendental function, which makes it far cheaper to
+     * compute than sigmoid or gaussian on microcontrollers without an FPU.
+     *
+     * @param x The input value to be transformed.
+     * @return The transformed output value after applying the ReLU function.
+     */
+    static inline double relu(double x) {
+        return x > 0 ? x : 0;
+    }
+
+    /**
+     * @brief Derivative of the ReLU activation function.
+     *
+     * @param x The weighted input of the neuron.
+     * @param y The output of the ReLU function for `x` (unused).
+     * @return 1 for positive inputs, 0 otherwise.
+     */
+    static inline double reluDerivative(double x, double y) {
+        (void) y;
+        return x > 0 ? 1.0 : 0.0;
+    }
+
+    /**
+     * @brief Leaky rectified linear unit activation function.
+     *
+     * The leaky ReLU function returns the input value when it is positive and scales it
+     * by the slope set with DiwaActivationFunc::initializeLeakyReLU() otherwise.
+     *
+     * @param x The input value to be transformed.
+     * @return The transformed output value after applying the leaky ReLU function.
+     */
+    static inline double leakyReLU(double x) {
+        return x > 0 ? x : x * DiwaActivationFunc::slope;
+    }
+
+    /**
+     * @brief Derivative of the leaky ReLU activation function.
+     *
+     * @param x The weighted input of the neuron.
+     * @param y The output of the leaky ReLU function for `x` (unused).
+     * @return 1 for positive inputs, the negative slope otherwise.
+     */
+    static inline double leakyReLUDerivative(double x, double y) {
+        (void) y;
+        return x > 0 ? 1.0 : DiwaActivationFunc::slope;
+    }
+
+    /**
+     * @brief Hard-sigmoid activation function.
+     *
+     * The hard-sigmoid function is a piecewise linear approximation of the sigmoid function,
+     * computed as `clamp(0.2 * x + 0.5, 0, 1)`. Its output is bounded between 0 and 1 just
+     * like sigmoid, but without calling `exp()`.
+     *
+     * @param x The input value to be transformed.
+     * @return The transformed output value after applying the hard-sigmoid function.
+     */
+    static inline double hardSigmoid(double x) {
+        double y = 0.2 * x + 0.5;
+
+        if(y < 0)
+            return 0;
+        if(y > 1)
+            return 1;
+
+        return y;
+    }
+
+    /**
+     * @brief Derivative of the hard-sigmoid activation function.
+     *
+     * @param x The weighted input of the neuron (unused).
+     * @param y The output of the hard-sigmoid function for `x`.
+     * @return 0.2 within the linear region, 0 where the output is saturated.
+     */
+    static inline double hardSigmoidDerivative(double x, double y) {
+        (void) x;
+        return (y > 0 && y < 1) ? 0.2 : 0.0;
+    }
+
+    /**
+     * @brief Hyperbolic tangent activation function.
+     *
+     * The tanh function produces outputs bounded between -1 and 1 and is centered around
+     * zero, which usually makes deeper networks converge faster than with sigmoid.
+     *
+     * @param x The input value to be transformed.
+     * @return The transformed output value after applying the tanh function.
+     */
+    static inline double tanh(double x) {
+        if(x < DIWA_ACTFUNC_LOWER_BOUND)
+            return -1;
+        if(x > DIWA_ACTFUNC_UPPER_BOUND)
+            return 1;
+
+        return ::tanh(x);
+    }
+
+    /**
+     * @brief Derivative of the hyperbolic tangent activation function.
+     *
+     * @param x The weighted input of the neuron (unused).
+     * @param y The output of the tanh function for `x`.
+     * @return The derivative of the tanh function, `1 - y * y`.
+     */
+    static inline double tanhDerivative(double x, double y) {
+        (void) x;
+        return 1.0 - y * y;
+    }
+
+    /**
+     * @brief Looks up the derivative paired with a built-in activation function.
+     *
+     * @param activation One of the activation functions of this class.
+     * @return The matching derivative, or `NULL` if the activation function is not
+     *         one of the built-in activation functions.
+     */
+    static inline diwa_activation_derivative derivativeOf(diwa_activation activation) {
+        if(activation == DiwaActivationFunc::sigmoid)
+            return DiwaActivationFunc::sigmoidDerivative;
+        if(activation == DiwaActivationFunc::gaussian)
+            return DiwaActivationFunc::gaussianDerivative;
+        if(activation == DiwaActivationFunc::radialBasis)
+            return DiwaActivationFunc::radialBasisDerivative;
+        if(activation == DiwaActivationFunc::relu)
+            return DiwaActivationFunc::reluDerivative;
+        if(activation == DiwaActivationFunc::leakyReLU)
+            return DiwaActivationFunc::leakyReLUDerivative;
+        if(activation == DiwaActivationFunc::hardSigmoid)
+            return DiwaActivationFunc::hardSigmoidDerivative;
+        if(activation == DiwaActivationFunc::tanh)
+            return DiwaActivationFunc::tanhDerivative;
+
+        return NULL;
+    }
 };
 
 #endif
\ No newline at end of file
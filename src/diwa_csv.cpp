@@ -0,0 +1,416 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_csv.h>
+
+#if (defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)) && \
+    !defined(ARDUINO)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DIWA_THREADS
+#   include <thread>
+#endif
+
+#if defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#   define DIWA_CSV_FROM_CHARS
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define DIWA_CSV_MMAP
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#define DIWA_CSV_MIN_CHUNK 65536 /**< Minimum size in bytes of the chunk parsed by a thread */
+
+typedef struct {
+    const char *begin;      /**< First character of the chunk */
+    const char *end;        /**< Character following the chunk */
+    int rows;               /**< Number of rows of the chunk */
+    int first;              /**< Row of the dataset at which the chunk starts */
+    int error;              /**< Row of the chunk of the first parsing error, or -1 */
+} diwa_csv_chunk;
+
+static bool parseNumber(const char *begin, const char *end, double *value) {
+    while(begin < end && *begin == ' ')
+        begin++;
+    while(end > begin && (end[-1] == ' ' || end[-1] == '\r'))
+        end--;
+
+    if(begin == end)
+        return false;
+
+    #ifdef DIWA_CSV_FROM_CHARS
+    if(*begin == '+')
+        begin++;
+
+    std::from_chars_result result = std::from_chars(begin, end, *value);
+    return result.ec == std::errc() && result.ptr == end;
+    #else
+    char field[64];
+    if(end - begin >= (long) sizeof(field))
+        return false;
+
+    memcpy(field, begin, end - begin);
+    field[end - begin] = '\0';
+
+    char *stop;
+    *value = strtod(field, &stop);
+    return stop == field + (end - begin);
+    #endif
+}
+
+static inline const char *nextLine(const char *line, const char *end, const char **lineEnd) {
+    const char *stop = (const char*) memchr(line, '\n', end - line);
+    if(stop == NULL)
+        stop = end;
+
+    *lineEnd = stop > line && stop[-1] == '\r' ? stop - 1 : stop;
+    return stop < end ? stop + 1 : end;
+}
+
+// Runs the task of every chunk, the first one on the calling thread
+template<typename T>
+static void forEachChunk(int threads, T& task) {
+    #ifdef DIWA_THREADS
+    std::thread *workers = new std::thread[threads];
+    for(int t = 1; t < threads; t++)
+        workers[t] = std::thread(task, t);
+    task(0);
+
+    for(int t = 1; t < threads; t++)
+        workers[t].join();
+    delete[] workers;
+    #else
+    for(int t = 0; t < threads; t++)
+        task(t);
+    #endif
+}
+
+DiwaCsvReader::DiwaCsvReader() {
+    this->delimiter = ',';
+    this->header = true;
+    this->threads = 0;
+
+    this->columns = NULL;
+    this->inputCount = 0;
+    this->targetCount = 0;
+
+    this->errorRow = -1;
+}
+
+DiwaCsvReader::~DiwaCsvReader() {
+    free(this->columns);
+}
+
+void DiwaCsvReader::setDelimiter(char delimiter) {
+    this->delimiter = delimiter;
+}
+
+void DiwaCsvReader::setHeader(bool header) {
+    this->header = header;
+}
+
+void DiwaCsvReader::setThreads(int threads) {
+    this->threads = threads > 0 ? threads : 0;
+}
+
+DiwaError DiwaCsvReader::select(int offset, const int *columns, int count, int keep) {
+    if(columns == NULL || count <= 0)
+        return INVALID_PARAM_VALUES;
+
+    for(int i = 0; i < count; i++)
+        if(columns[i] < 0)
+            return INVALID_PARAM_VALUES;
+
+    int *buffer = (int*) malloc(sizeof(int) * (offset + count + keep));
+    if(buffer == NULL)
+        return MALLOC_FAILED;
+
+    if(this->columns != NULL) {
+        memcpy(buffer, this->columns, sizeof(int) * offset);
+        memcpy(buffer + offset + count, this->columns + this->inputCount, sizeof(int) * keep);
+    }
+    memcpy(buffer + offset, columns, sizeof(int) * count);
+
+    free(this->columns);
+    this->columns = buffer;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaCsvReader::setInputColumns(const int *columns, int count) {
+    DiwaError error = this->select(0, columns, count, this->targetCount);
+
+    if(error == NO_ERROR)
+        this->inputCount = count;
+    return error;
+}
+
+DiwaError DiwaCsvReader::setTargetColumns(const int *columns, int count) {
+    DiwaError error = this->select(this->inputCount, columns, count, 0);
+
+    if(error == NO_ERROR)
+        this->targetCount = count;
+    return error;
+}
+
+DiwaError DiwaCsvReader::read(const char *path, DiwaDataset& dataset) {
+    this->errorRow = -1;
+    if(this->inputCount <= 0 || this->targetCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    const char *data;
+    size_t size;
+
+    #ifdef DIWA_CSV_MMAP
+    int descriptor = open(path, O_RDONLY);
+    if(descriptor < 0)
+        return STREAM_NOT_OPEN;
+
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        close(descriptor);
+        return MODEL_READ_ERROR;
+    }
+
+    size = status.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+
+    if(mapping == MAP_FAILED)
+        return MODEL_READ_ERROR;
+
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    data = (const char*) mapping;
+    #else
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+        return STREAM_NOT_OPEN;
+
+    // ftell() returns a 32-bit long on Windows
+    #ifdef _WIN32
+    const long long length = _fseeki64(file, 0, SEEK_END) == 0 ?
+        _ftelli64(file) : -1;
+    #else
+    const long long length = fseek(file, 0, SEEK_END) == 0 ?
+        (long long) ftell(file) : -1;
+    #endif
+
+    if(length < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return MODEL_READ_ERROR;
+    }
+
+    if((unsigned long long) length > SIZE_MAX) {
+        fclose(file);
+        return MALLOC_FAILED;
+    }
+
+    size = (size_t) length;
+    char *contents = (char*) malloc(size > 0 ? size : 1);
+    if(contents == NULL) {
+        fclose(file);
+        return MALLOC_FAILED;
+    }
+
+    size = fread(contents, 1, size, file);
+    fclose(file);
+    data = contents;
+    #endif
+
+    DiwaError error = this->parse(data, size, dataset);
+
+    #ifdef DIWA_CSV_MMAP
+    munmap(mapping, size);
+    #else
+    free(contents);
+    #endif
+
+    return error;
+}
+
+DiwaError DiwaCsvReader::parse(const char *data, size_t size, DiwaDataset& dataset) {
+    int columnCount = 0;
+    for(int i = 0; i < this->inputCount + this->targetCount; i++)
+        if(this->columns[i] >= columnCount)
+            columnCount = this->columns[i] + 1;
+
+    #ifdef DIWA_THREADS
+    int threads = this->threads;
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    int threads = 1;
+    #endif
+
+    if((size_t) threads > size / DIWA_CSV_MIN_CHUNK)
+        threads = (int) (size / DIWA_CSV_MIN_CHUNK);
+    if(threads <= 0)
+        threads = 1;
+
+    diwa_csv_chunk *chunks = (diwa_csv_chunk*) malloc(sizeof(diwa_csv_chunk) * threads);
+    double *values = (double*) malloc(sizeof(double) * columnCount * threads);
+    char *wanted = (char*) calloc(columnCount, 1);
+
+    if(chunks == NULL || values == NULL || wanted == NULL) {
+        free(chunks);
+        free(values);
+        free(wanted);
+
+        return MALLOC_FAILED;
+    }
+
+    int distinct = 0;
+    for(int i = 0; i < this->inputCount + this->targetCount; i++)
+        if(!wanted[this->columns[i]]) {
+            wanted[this->columns[i]] = 1;
+            distinct++;
+        }
+
+    const char *end = data + size, *start = data, *lineEnd;
+    if(this->header)
+        start = nextLine(data, end, &lineEnd);
+
+    for(int t = 0; t < threads; t++) {
+        const char *boundary = start + (size_t) (end - start) * t / threads;
+        if(t > 0 && boundary > start && boundary[-1] != '\n')
+            boundary = nextLine(boundary, end, &lineEnd);
+
+        chunks[t].begin = t > 0 && boundary < chunks[t - 1].begin ?
+            chunks[t - 1].begin : boundary;
+        chunks[t].rows = 0;
+        chunks[t].error = -1;
+
+        if(t > 0)
+            chunks[t - 1].end = chunks[t].begin;
+    }
+    chunks[threads - 1].end = end;
+
+    auto countRows = [chunks](int t) {
+        const char *lineEnd;
+
+        for(const char *line = chunks[t].begin; line < chunks[t].end;) {
+            const char *next = nextLine(line, chunks[t].end, &lineEnd);
+
+            if(lineEnd > line)
+                chunks[t].rows++;
+            line = next;
+        }
+    };
+
+    auto parseRows = [&](int t) {
+        double *fields = values + t * columnCount;
+        double *inputs = dataset.getInputs() + (size_t) chunks[t].first * this->inputCount;
+        double *targets = dataset.getTargets() + (size_t) chunks[t].first * this->targetCount;
+        const char *lineEnd;
+        int row = 0;
+
+        for(const char *line = chunks[t].begin; line < chunks[t].end;) {
+            const char *next = nextLine(line, chunks[t].end, &lineEnd);
+            if(lineEnd == line) {
+                line = next;
+                continue;
+            }
+
+            int parsed = 0;
+            for(int column = 0;; column++) {
+                const char *fieldEnd = (const char*) memchr(line, this->delimiter, lineEnd - line);
+                if(fieldEnd == NULL)
+                    fieldEnd = lineEnd;
+
+                if(wanted[column]) {
+                    if(!parseNumber(line, fieldEnd, fields + column))
+                        break;
+                    parsed++;
+                }
+
+                if(fieldEnd == lineEnd || column + 1 == columnCount)
+                    break;
+                line = fieldEnd + 1;
+            }
+
+            if(parsed != distinct) {
+                chunks[t].error = row;
+                return;
+            }
+
+            for(int i = 0; i < this->inputCount; i++)
+                *inputs++ = fields[this->columns[i]];
+            for(int i = 0; i < this->targetCount; i++)
+                *targets++ = fields[this->columns[this->inputCount + i]];
+
+            row++;
+            line = next;
+        }
+    };
+
+    forEachChunk(threads, countRows);
+
+    int samples = 0;
+    for(int t = 0; t < threads; t++) {
+        chunks[t].first = samples;
+        samples += chunks[t].rows;
+    }
+
+    DiwaError error = samples > 0 ?
+        dataset.initialize(samples, this->inputCount, this->targetCount) :
+        MODEL_READ_ERROR;
+
+    if(error == NO_ERROR) {
+        forEachChunk(threads, parseRows);
+
+        for(int t = 0; t < threads && error == NO_ERROR; t++)
+            if(chunks[t].error >= 0) {
+                this->errorRow = chunks[t].first + chunks[t].error;
+                error = MODEL_READ_ERROR;
+            }
+    }
+
+    free(chunks);
+    free(values);
+    free(wanted);
+
+    return error;
+}
+
+int DiwaCsvReader::getErrorRow() const {
+    return this->errorRow;
+}
+
+#endif
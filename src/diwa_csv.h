@@ -0,0 +1,176 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_csv.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaCsvReader class, which loads
+ *        numeric CSV and TSV files into a DiwaDataset.
+ *
+ * The DiwaCsvReader class reads large numeric CSV files in parallel. The file is split into
+ * one chunk per thread, and every chunk boundary is moved to the start of the next line, so
+ * that each line is parsed by exactly one thread. A first pass counts the rows of every
+ * chunk, which gives the row at which each chunk starts; the second pass parses the selected
+ * columns of every row straight into the storage of the dataset. Numbers are parsed with
+ * `std::from_chars` when the standard library supports it for floating-point values, and
+ * with `strtod()` otherwise.
+ *
+ * @note Empty lines are skipped, and lines may end with `\r\n`. Quoted fields are not
+ *       supported. This class is only available on desktop platforms, and parses the whole
+ *       file on the calling thread where `std::thread` is not available.
+ */
+
+#ifndef DIWA_CSV_H
+#define DIWA_CSV_H
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+
+#if (defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)) && \
+    !defined(ARDUINO)
+
+/**
+ *
+ * @class DiwaCsvReader
+ * @brief Parallel reader of numeric CSV files.
+ *
+ * The columns holding the input values and the target values
+ * of the samples are selected by their zero-based indices, in
+ * any order; other columns are skipped without being parsed.
+ *
+ */
+class DiwaCsvReader final {
+private:
+    char delimiter;         /**< Character separating the fields of a line */
+    bool header;            /**< Whether the first line holds column names */
+    int threads;            /**< Number of parsing threads */
+
+    int *columns;           /**< Input columns followed by target columns */
+    int inputCount;         /**< Number of input columns */
+    int targetCount;        /**< Number of target columns */
+
+    int errorRow;           /**< Zero-based row of the first parsing error, or -1 */
+
+    /**
+     * @brief Selects columns of the file.
+     *
+     * @param offset Position of the first column to replace within the column array.
+     * @param columns Indices of the columns.
+     * @param count Number of columns.
+     * @param keep Number of columns kept after the replaced ones.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError select(int offset, const int *columns, int count, int keep);
+
+    /**
+     * @brief Parses the contents of a file into a dataset.
+     *
+     * @param data Contents of the file.
+     * @param size Size of the contents in bytes.
+     * @param dataset Dataset receiving the samples.
+     * @return DiwaError indicating the parsing status.
+     */
+    DiwaError parse(const char *data, size_t size, DiwaDataset& dataset);
+
+public:
+    /**
+     * @brief Default constructor for the DiwaCsvReader class.
+     *
+     * The reader defaults to comma-separated fields with a header line, and to one
+     * parsing thread per hardware thread.
+     */
+    DiwaCsvReader();
+
+    /**
+     * @brief Destructor for the DiwaCsvReader class.
+     */
+    ~DiwaCsvReader();
+
+    /**
+     * @brief Sets the character separating the fields of a line.
+     *
+     * @param delimiter The field delimiter, e.g. ',' for CSV or '\\t' for TSV.
+     */
+    void setDelimiter(char delimiter);
+
+    /**
+     * @brief Sets whether the first line of the file holds column names.
+     *
+     * @param header True to skip the first line.
+     */
+    void setHeader(bool header);
+
+    /**
+     * @brief Sets the number of parsing threads.
+     *
+     * @param threads Number of threads, or 0 for one per hardware thread. Ignored on
+     *                platforms without `std::thread`, where a single thread is used.
+     */
+    void setThreads(int threads);
+
+    /**
+     * @brief Selects the columns holding the input values.
+     *
+     * @param columns Zero-based indices of the columns, in the order of the input neurons.
+     * @param count Number of input columns.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError setInputColumns(const int *columns, int count);
+
+    /**
+     * @brief Selects the columns holding the target values.
+     *
+     * @param columns Zero-based indices of the columns, in the order of the output neurons.
+     * @param count Number of target columns.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError setTargetColumns(const int *columns, int count);
+
+    /**
+     * @brief Reads a file into a dataset.
+     *
+     * The dataset is initialized with one sample per non-empty line of the file (besides
+     * the header line), in the order of the lines.
+     *
+     * @param path Path of the CSV file.
+     * @param dataset Dataset receiving the samples.
+     * @return DiwaError indicating the reading status, MODEL_READ_ERROR if a selected
+     *         field is missing or is not a number.
+     */
+    DiwaError read(const char *path, DiwaDataset& dataset);
+
+    /**
+     * @brief Get the row of the first parsing error of the last read.
+     *
+     * @return The zero-based row (not counting the header line and empty lines) of the
+     *         first row that could not be parsed, or -1.
+     */
+    int getErrorRow() const;
+};
+
+#endif
+
+#endif  // DIWA_CSV_H
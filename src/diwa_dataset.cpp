@@ -0,0 +1,272 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_dataset.h>
+#include <diwa_npy.h>
+#include <stdlib.h>
+#include <string.h>
+
+DiwaDataset::DiwaDataset() {
+    this->buffer = NULL;
+    this->inputs = NULL;
+    this->targets = NULL;
+    this->indices = NULL;
+
+    this->inputCount = 0;
+    this->targetCount = 0;
+    this->rows = 0;
+    this->samples = 0;
+}
+
+DiwaDataset::~DiwaDataset() {
+    this->release();
+}
+
+void DiwaDataset::release() {
+    free(this->buffer);
+    free(this->indices);
+
+    this->buffer = NULL;
+    this->inputs = NULL;
+    this->targets = NULL;
+    this->indices = NULL;
+
+    this->rows = 0;
+    this->samples = 0;
+}
+
+DiwaError DiwaDataset::initialize(int samples, int inputCount, int targetCount) {
+    if(samples <= 0 || inputCount <= 0 || targetCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    this->release();
+
+    const size_t alignment = DIWA_DATASET_ALIGNMENT;
+    const size_t inputBytes = (sizeof(double) * samples * inputCount +
+        alignment - 1) & ~(alignment - 1);
+    const size_t targetBytes = sizeof(double) * samples * targetCount;
+
+    this->buffer = calloc(inputBytes + targetBytes + alignment, 1);
+    this->indices = (int*) malloc(sizeof(int) * samples);
+
+    if(this->buffer == NULL || this->indices == NULL) {
+        this->release();
+        return MALLOC_FAILED;
+    }
+
+    this->inputs = (double*) (((uintptr_t) this->buffer + alignment - 1) & ~(uintptr_t) (alignment - 1));
+    this->targets = (double*) ((uint8_t*) this->inputs + inputBytes);
+
+    this->inputCount = inputCount;
+    this->targetCount = targetCount;
+    this->rows = samples;
+    this->samples = samples;
+
+    for(int i = 0; i < samples; i++)
+        this->indices[i] = i;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaDataset::initialize(
+    const double *inputs,
+    const double *targets,
+    int samples,
+    int inputCount,
+    int targetCount
+) {
+    if(inputs == NULL || targets == NULL)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = this->initialize(samples, inputCount, targetCount)) != NO_ERROR)
+        return error;
+
+    memcpy(this->inputs, inputs, sizeof(double) * samples * inputCount);
+    memcpy(this->targets, targets, sizeof(double) * samples * targetCount);
+
+    return NO_ERROR;
+}
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+DiwaError DiwaDataset::initialize(const DiwaNpy& inputs, const DiwaNpy& targets) {
+    const int samples = inputs.getRows();
+    if(samples <= 0 || targets.getRows() != samples)
+        return INVALID_PARAM_VALUES;
+
+    if(inputs.isSinglePrecision() || targets.isSinglePrecision()) {
+        DiwaError error;
+        if((error = this->initialize(samples, inputs.getColumns(), targets.getColumns())) != NO_ERROR)
+            return error;
+
+        for(int i = 0; i < samples; i++) {
+            inputs.getRow(i, this->inputs + (size_t) i * this->inputCount);
+            targets.getRow(i, this->targets + (size_t) i * this->targetCount);
+        }
+
+        return NO_ERROR;
+    }
+
+    int *indices = (int*) malloc(sizeof(int) * samples);
+    if(indices == NULL)
+        return MALLOC_FAILED;
+
+    this->release();
+
+    this->inputs = inputs.getDoubles();
+    this->targets = targets.getDoubles();
+    this->indices = indices;
+
+    this->inputCount = inputs.getColumns();
+    this->targetCount = targets.getColumns();
+    this->rows = samples;
+    this->samples = samples;
+
+    for(int i = 0; i < samples; i++)
+        this->indices[i] = i;
+
+    return NO_ERROR;
+}
+#endif
+
+DiwaError DiwaDataset::setRow(int row, const double *inputs, const double *targets) {
+    if(row < 0 || row >= this->rows)
+        return INVALID_PARAM_VALUES;
+
+    memcpy(this->inputs + (size_t) row * this->inputCount, inputs, sizeof(double) * this->inputCount);
+    memcpy(this->targets + (size_t) row * this->targetCount, targets, sizeof(double) * this->targetCount);
+
+    return NO_ERROR;
+}
+
+void DiwaDataset::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+}
+
+void DiwaDataset::shuffle() {
+    for(int i = this->samples - 1; i > 0; i--) {
+        const int j = (int) (this->randomizer.next() % (uint64_t) (i + 1));
+        const int row = this->indices[i];
+
+        this->indices[i] = this->indices[j];
+        this->indices[j] = row;
+    }
+}
+
+DiwaError DiwaDataset::view(const DiwaDataset& source, int first, int count) {
+    int *indices = (int*) malloc(sizeof(int) * count);
+    if(indices == NULL)
+        return MALLOC_FAILED;
+
+    memcpy(indices, source.indices + first, sizeof(int) * count);
+    this->release();
+
+    this->inputs = source.inputs;
+    this->targets = source.targets;
+    this->indices = indices;
+
+    this->inputCount = source.inputCount;
+    this->targetCount = source.targetCount;
+    this->rows = source.rows;
+    this->samples = count;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaDataset::split(
+    double validationFraction,
+    DiwaDataset& training,
+    DiwaDataset& validation
+) const {
+    const int validationSamples = (int) (this->samples * validationFraction + 0.5);
+    const int trainingSamples = this->samples - validationSamples;
+
+    if(&training == this || &validation == this || &training == &validation ||
+        validationSamples <= 0 || trainingSamples <= 0)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = training.view(*this, 0, trainingSamples)) != NO_ERROR)
+        return error;
+
+    return validation.view(*this, trainingSamples, validationSamples);
+}
+
+DiwaError DiwaDataset::fold(
+    int folds,
+    int fold,
+    DiwaDataset& training,
+    DiwaDataset& validation
+) const {
+    if(&training == this || &validation == this || &training == &validation ||
+        folds < 2 || folds > this->samples || fold < 0 || fold >= folds)
+        return INVALID_PARAM_VALUES;
+
+    const int first = (int) ((long long) this->samples * fold / folds);
+    const int count = (int) ((long long) this->samples * (fold + 1) / folds) - first;
+
+    DiwaError error;
+    if((error = training.view(*this, 0, this->samples - count)) != NO_ERROR ||
+        (error = validation.view(*this, first, count)) != NO_ERROR)
+        return error;
+
+    memcpy(
+        training.indices + first,
+        this->indices + first + count,
+        sizeof(int) * (this->samples - first - count)
+    );
+
+    return NO_ERROR;
+}
+
+int DiwaDataset::getBatchCount(int batchSize) const {
+    return batchSize > 0 ? (this->samples + batchSize - 1) / batchSize : 0;
+}
+
+double *DiwaDataset::getSampleInputs(int position) const {
+    return this->inputs + (size_t) this->indices[position] * this->inputCount;
+}
+
+double *DiwaDataset::getSampleTargets(int position) const {
+    return this->targets + (size_t) this->indices[position] * this->targetCount;
+}
+
+double *DiwaDataset::getInputs() const {
+    return this->inputs;
+}
+
+double *DiwaDataset::getTargets() const {
+    return this->targets;
+}
+
+int DiwaDataset::getSampleCount() const {
+    return this->samples;
+}
+
+int DiwaDataset::getInputCount() const {
+    return this->inputCount;
+}
+
+int DiwaDataset::getTargetCount() const {
+    return this->targetCount;
+}
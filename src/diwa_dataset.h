@@ -0,0 +1,274 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_dataset.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaDataset class, a container
+ *        holding the samples used to train the Diwa neural network.
+ *
+ * The DiwaDataset class stores the input values and the target values of every sample in
+ * a single aligned allocation: the inputs of all samples, followed by the targets of all
+ * samples, each block being contiguous and row-major. The order in which the samples are
+ * visited is a separate permutation of sample indices, so shuffling, splitting and batching
+ * never move the samples themselves.
+ *
+ * @note Splitting a dataset gives views, i.e. datasets that share the storage of the split
+ *       dataset and only own their index permutation. A view must not outlive the dataset
+ *       that owns the storage. Likewise, a dataset initialized from float64 NumPy arrays
+ *       uses the mapped arrays as its storage, and must not outlive them.
+ */
+
+#ifndef DIWA_DATASET_H
+#define DIWA_DATASET_H
+
+#include <diwa.h>
+
+class DiwaNpy;
+
+#ifndef DIWA_DATASET_ALIGNMENT
+#   define DIWA_DATASET_ALIGNMENT 64 /**< Alignment in bytes of the input and target blocks */
+#endif
+
+/**
+ *
+ * @class DiwaDataset
+ * @brief Contiguous storage of training samples with
+ *        index-based shuffling, splitting and batching.
+ *
+ * Samples are addressed in two ways: by row, i.e. their
+ * position in the storage, and by position in the current
+ * order of the dataset. Methods taking a position, such as
+ * getSampleInputs(), follow the order set by shuffle().
+ *
+ */
+class DiwaDataset final {
+private:
+    void *buffer;           /**< Allocation holding the inputs and targets, NULL for views */
+    double *inputs;         /**< Input values of every row */
+    double *targets;        /**< Target values of every row */
+    int *indices;           /**< Rows of the dataset, in the order they are visited */
+
+    int inputCount;         /**< Number of input values per sample */
+    int targetCount;        /**< Number of target values per sample */
+    int rows;               /**< Number of rows in the storage */
+    int samples;            /**< Number of samples of the dataset */
+
+    DiwaRandom randomizer;  /**< Pseudo-random number generator used for shuffling */
+
+    /**
+     * @brief Releases the storage and the index permutation.
+     */
+    void release();
+
+    /**
+     * @brief Makes this dataset a view over a range of the order of another dataset.
+     *
+     * @param source Dataset whose storage is shared.
+     * @param first Position of the first sample of the view within the source order.
+     * @param count Number of samples of the view.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError view(const DiwaDataset& source, int first, int count);
+
+public:
+    /**
+     * @brief Default constructor for the DiwaDataset class.
+     *
+     * Constructs an empty dataset.
+     */
+    DiwaDataset();
+
+    /**
+     * @brief Destructor for the DiwaDataset class.
+     *
+     * Releases the storage of the dataset, unless it is a view or uses mapped arrays.
+     */
+    ~DiwaDataset();
+
+    /**
+     * @brief Allocates storage for a dataset.
+     *
+     * Every input and target value is initialized to zero, and the samples are
+     * visited in the order of their rows.
+     *
+     * @param samples Number of samples of the dataset.
+     * @param inputCount Number of input values per sample.
+     * @param targetCount Number of target values per sample.
+     * @return DiwaError indicating the initialization status.
+     */
+    DiwaError initialize(int samples, int inputCount, int targetCount);
+
+    /**
+     * @brief Allocates storage for a dataset and copies the samples into it.
+     *
+     * @param inputs Contiguous input values of the samples.
+     * @param targets Contiguous target values of the samples.
+     * @param samples Number of samples of the dataset.
+     * @param inputCount Number of input values per sample.
+     * @param targetCount Number of target values per sample.
+     * @return DiwaError indicating the initialization status.
+     */
+    DiwaError initialize(
+        const double *inputs,
+        const double *targets,
+        int samples,
+        int inputCount,
+        int targetCount
+    );
+
+    #if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+    /**
+     * @brief Initializes a dataset from NumPy arrays.
+     *
+     * When both arrays hold float64 values, the dataset uses them in place as its
+     * storage, without copying them. Otherwise the values are converted into storage
+     * allocated by the dataset.
+     *
+     * @param inputs Mapped array holding the input values of one sample per row.
+     * @param targets Mapped array holding the target values of one sample per row.
+     * @return DiwaError indicating the initialization status.
+     */
+    DiwaError initialize(const DiwaNpy& inputs, const DiwaNpy& targets);
+    #endif
+
+    /**
+     * @brief Sets the values of a row.
+     *
+     * @param row Index of the row in the storage.
+     * @param inputs Input values of the sample.
+     * @param targets Target values of the sample.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError setRow(int row, const double *inputs, const double *targets);
+
+    /**
+     * @brief Seeds the pseudo-random number generator used for shuffling.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Shuffles the order of the samples.
+     *
+     * Only the index permutation is shuffled; the samples stay in place.
+     */
+    void shuffle();
+
+    /**
+     * @brief Splits the dataset into a training and a validation dataset.
+     *
+     * The first samples of the current order go to the training dataset and the rest
+     * to the validation dataset. Both are views sharing the storage of this dataset.
+     *
+     * @param validationFraction Fraction of the samples going to the validation dataset, within (0, 1).
+     * @param training Dataset receiving the training view.
+     * @param validation Dataset receiving the validation view.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError split(double validationFraction, DiwaDataset& training, DiwaDataset& validation) const;
+
+    /**
+     * @brief Splits the dataset into the training and validation datasets of a k-fold split.
+     *
+     * The current order is cut into `folds` ranges of nearly equal size. The range of the
+     * given fold goes to the validation dataset and the other ones, in order, to the training
+     * dataset. Both are views sharing the storage of this dataset.
+     *
+     * @param folds Number of folds, at least 2 and at most the number of samples.
+     * @param fold Index of the fold held out for validation.
+     * @param training Dataset receiving the training view.
+     * @param validation Dataset receiving the validation view.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError fold(int folds, int fold, DiwaDataset& training, DiwaDataset& validation) const;
+
+    /**
+     * @brief Get the number of batches of an epoch.
+     *
+     * Batch `b` holds the samples at positions `b * batchSize` up to, but excluding,
+     * `(b + 1) * batchSize`; the last batch may be smaller.
+     *
+     * @param batchSize Number of samples per batch.
+     * @return The number of batches needed to visit every sample once.
+     */
+    int getBatchCount(int batchSize) const;
+
+    /**
+     * @brief Get the input values of a sample.
+     *
+     * @param position Position of the sample in the current order.
+     * @return Pointer to the `getInputCount()` input values of the sample.
+     */
+    double *getSampleInputs(int position) const;
+
+    /**
+     * @brief Get the target values of a sample.
+     *
+     * @param position Position of the sample in the current order.
+     * @return Pointer to the `getTargetCount()` target values of the sample.
+     */
+    double *getSampleTargets(int position) const;
+
+    /**
+     * @brief Get the input values of every row.
+     *
+     * The input values are contiguous and in storage order, as expected by the
+     * DiwaTrainer and DiwaEvolution classes. For views, this is the storage of
+     * the dataset they were split from.
+     *
+     * @return Pointer to the input values of the first row.
+     */
+    double *getInputs() const;
+
+    /**
+     * @brief Get the target values of every row.
+     *
+     * @return Pointer to the target values of the first row, in storage order.
+     */
+    double *getTargets() const;
+
+    /**
+     * @brief Get the number of samples of the dataset.
+     *
+     * @return The number of samples, i.e. of positions in the order of the dataset.
+     */
+    int getSampleCount() const;
+
+    /**
+     * @brief Get the number of input values per sample.
+     *
+     * @return The number of input values per sample.
+     */
+    int getInputCount() const;
+
+    /**
+     * @brief Get the number of target values per sample.
+     *
+     * @return The number of target values per sample.
+     */
+    int getTargetCount() const;
+};
+
+#endif  // DIWA_DATASET_H
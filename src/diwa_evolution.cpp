@@ -0,0 +1,323 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_evolution.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DIWA_THREADS
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#endif
+
+static double halfSquaredError(const double *outputs, const double *targets, int count) {
+    double loss = 0;
+
+    for(int j = 0; j < count; j++)
+        loss += 0.5 * (targets[j] - outputs[j]) * (targets[j] - outputs[j]);
+    return loss;
+}
+
+static double crossEntropy(const double *outputs, const double *targets, int count) {
+    double loss = 0;
+
+    for(int j = 0; j < count; j++)
+        if(targets[j] != 0)
+            loss -= targets[j] * log(outputs[j] > 1e-12 ? outputs[j] : 1e-12);
+    return loss;
+}
+
+DiwaEvolution::DiwaEvolution(Diwa& network, int population, int threads) {
+    this->network = &network;
+    this->population = population > 2 ? population + (population & 1) : 2;
+
+    #ifdef DIWA_THREADS
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    threads = 1;
+    #endif
+
+    if(threads <= 0)
+        threads = 1;
+    if(threads > this->population / 2)
+        threads = this->population / 2;
+    this->threads = threads;
+
+    this->sigma = 0.1;
+    this->learningRate = 0.05;
+    this->seed = 0;
+    this->objective = NULL;
+
+    this->arena = NULL;
+    this->arenaSize = 0;
+
+    this->generations = 0;
+    this->loss = 0;
+}
+
+DiwaEvolution::~DiwaEvolution() {
+    free(this->arena);
+}
+
+void DiwaEvolution::setNoise(double sigma) {
+    this->sigma = sigma;
+}
+
+void DiwaEvolution::setLearningRate(double learningRate) {
+    this->learningRate = learningRate;
+}
+
+void DiwaEvolution::setSeed(uint64_t seed) {
+    this->seed = seed;
+}
+
+void DiwaEvolution::setObjective(diwa_objective objective) {
+    this->objective = objective;
+}
+
+DiwaError DiwaEvolution::allocate() {
+    const int count = this->network->weightCount;
+    if(this->arena != NULL && this->arenaSize == count)
+        return NO_ERROR;
+
+    free(this->arena);
+    this->arena = (double*) malloc(sizeof(double) * (
+        this->population * count +
+        this->population / 2 * count +
+        this->population +
+        this->threads * this->network->neuronCount +
+        this->population
+    ));
+
+    if(this->arena == NULL) {
+        this->arenaSize = 0;
+        return MALLOC_FAILED;
+    }
+
+    this->arenaSize = count;
+    this->candidates = this->arena;
+    this->noise = this->candidates + this->population * count;
+    this->losses = this->noise + this->population / 2 * count;
+    this->scratch = this->losses + this->population;
+    this->ranking = (int*) (this->scratch + this->threads * this->network->neuronCount);
+
+    return NO_ERROR;
+}
+
+double DiwaEvolution::score(
+    const double *weights,
+    double *outputs,
+    const double *inputs,
+    const double *targets,
+    int samples
+) const {
+    const int inputCount = this->network->inputNeurons;
+    const int outputCount = this->network->outputNeurons;
+
+    diwa_objective objective = this->objective;
+    if(objective == NULL)
+        objective = this->network->outputMode == SOFTMAX_OUTPUT ?
+            crossEntropy : halfSquaredError;
+
+    double loss = 0;
+    for(int i = 0; i < samples; i++)
+        loss += objective(
+            this->network->forward<double>(
+                weights, outputs,
+                inputs + i * inputCount,
+                NULL, false
+            ),
+            targets + i * outputCount,
+            outputCount
+        );
+
+    loss /= samples;
+    return isnan(loss) ? HUGE_VAL : loss;
+}
+
+void DiwaEvolution::evaluate(
+    int worker,
+    int generation,
+    const double *inputs,
+    const double *targets,
+    int samples
+) {
+    const int count = this->network->weightCount;
+    const int offset = this->network->getTrainableOffset();
+    const double *weights = this->network->weights;
+    double *outputs = this->scratch + worker * this->network->neuronCount;
+
+    for(int pair = worker; pair < this->population / 2; pair += this->threads) {
+        DiwaRandom randomizer;
+        randomizer.seed(this->seed + (uint64_t) generation * (this->population / 2) + pair);
+
+        double *noise = this->noise + pair * count;
+        double *positive = this->candidates + (2 * pair) * count;
+        double *negative = positive + count;
+
+        // Frozen weights are shared by every candidate and never perturbed
+        memcpy(positive, weights, sizeof(double) * offset);
+        memcpy(negative, weights, sizeof(double) * offset);
+
+        for(int i = offset; i < count; i++) {
+            noise[i] = randomizer.nextGaussian(0, 1);
+
+            positive[i] = weights[i] + this->sigma * noise[i];
+            negative[i] = weights[i] - this->sigma * noise[i];
+        }
+
+        this->losses[2 * pair] = this->score(positive, outputs, inputs, targets, samples);
+        this->losses[2 * pair + 1] = this->score(negative, outputs, inputs, targets, samples);
+    }
+}
+
+DiwaError DiwaEvolution::evolve(
+    const double *inputs,
+    const double *targets,
+    int samples,
+    int generations,
+    double targetLoss
+) {
+    if(samples <= 0 || generations <= 0 ||
+        this->network->weightCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = this->allocate()) != NO_ERROR)
+        return error;
+
+    const int count = this->network->weightCount;
+    const int offset = this->network->getTrainableOffset();
+    double *weights = this->network->weights;
+
+    #ifdef DIWA_THREADS
+    std::mutex lock;
+    std::condition_variable wake, done;
+    int issued = -1, pending = 0;
+    bool stop = false;
+
+    std::thread *workers = new std::thread[this->threads - 1];
+    for(int t = 1; t < this->threads; t++)
+        workers[t - 1] = std::thread([&, t]() {
+            for(int seen = -1;;) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    wake.wait(guard, [&]() { return stop || issued != seen; });
+
+                    if(stop)
+                        return;
+                    seen = issued;
+                }
+
+                this->evaluate(t, seen, inputs, targets, samples);
+
+                std::lock_guard<std::mutex> guard(lock);
+                if(--pending == 0)
+                    done.notify_one();
+            }
+        });
+    #endif
+
+    this->loss = this->score(weights, this->scratch, inputs, targets, samples);
+    for(this->generations = 0; this->generations < generations; ) {
+        if(this->loss <= targetLoss)
+            break;
+
+        #ifdef DIWA_THREADS
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            issued = this->generations;
+            pending = this->threads - 1;
+        }
+        wake.notify_all();
+        #endif
+
+        this->evaluate(0, this->generations, inputs, targets, samples);
+
+        #ifdef DIWA_THREADS
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            done.wait(guard, [&]() { return pending == 0; });
+        }
+        #endif
+
+        for(int i = 0; i < this->population; i++) {
+            int j = i;
+
+            for(; j > 0 && this->losses[this->ranking[j - 1]] > this->losses[i]; j--)
+                this->ranking[j] = this->ranking[j - 1];
+            this->ranking[j] = i;
+        }
+
+        for(int r = 0; r < this->population; r++)
+            this->losses[this->ranking[r]] = 0.5 - (double) r / (this->population - 1);
+
+        const double step = this->learningRate / (this->population * this->sigma);
+        for(int pair = 0; pair < this->population / 2; pair++) {
+            const double factor = step *
+                (this->losses[2 * pair] - this->losses[2 * pair + 1]);
+            const double *noise = this->noise + pair * count;
+
+            for(int i = offset; i < count; i++)
+                weights[i] += factor * noise[i];
+        }
+
+        this->generations++;
+        this->loss = this->score(weights, this->scratch, inputs, targets, samples);
+    }
+
+    #ifdef DIWA_THREADS
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    wake.notify_all();
+
+    for(int t = 1; t < this->threads; t++)
+        workers[t - 1].join();
+    delete[] workers;
+    #endif
+
+    if(this->generations > 0) {
+        const double *best = this->candidates + this->ranking[0] * count;
+        const double bestLoss = this->score(best, this->scratch, inputs, targets, samples);
+
+        if(bestLoss < this->loss) {
+            memcpy(weights + offset, best + offset, sizeof(double) * (count - offset));
+            this->loss = bestLoss;
+        }
+    }
+
+    this->network->reducedStale = true;
+    return NO_ERROR;
+}
+
+int DiwaEvolution::getGenerations() const {
+    return this->generations;
+}
+
+double DiwaEvolution::getLoss() const {
+    return this->loss;
+}
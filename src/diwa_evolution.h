@@ -0,0 +1,223 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_evolution.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaEvolution class, a
+ *        gradient-free trainer for the Diwa neural network.
+ *
+ * The DiwaEvolution class trains a Diwa neural network with natural evolution strategies.
+ * Every generation, a population of candidate weight vectors is sampled around the current
+ * weights using antithetic Gaussian noise, each candidate is scored on the dataset, and the
+ * weights move along the rank-weighted average of the noise. Since no gradient is involved,
+ * any objective can be minimized, including non-differentiable ones, and activation functions
+ * with flat or clamped regions such as DiwaActivationFunc::gaussian can be trained.
+ *
+ * @note On desktop platforms, candidates are scored in parallel by worker threads which
+ *       share the dataset read-only. Candidate weights live in a population arena allocated
+ *       once per call to evolve(), so no allocation happens from one generation to the next.
+ *       On Arduino, candidates are scored sequentially.
+ */
+
+#ifndef DIWA_EVOLUTION_H
+#define DIWA_EVOLUTION_H
+
+#include <diwa.h>
+
+/**
+ * @brief Typedef for objective function pointer.
+ *
+ * This typedef defines the signature for the per-sample objectives minimized by the
+ * DiwaEvolution class. An objective receives the outputs of the network for a sample
+ * and the target values of that sample, and returns the loss of the sample. The loss
+ * of a candidate is the mean objective over the dataset.
+ */
+typedef double (*diwa_objective)(const double *outputs, const double *targets, int count);
+
+/**
+ *
+ * @class DiwaEvolution
+ * @brief Parallel evolution strategies trainer for the
+ *        Diwa neural network.
+ *
+ * The DiwaEvolution class implements antithetic natural
+ * evolution strategies with centered rank fitness shaping.
+ * The noise of each candidate pair is generated from its own
+ * seeded DiwaRandom generator, so the result of a run only
+ * depends on the seed and not on the number of threads.
+ *
+ */
+class DiwaEvolution final {
+private:
+    Diwa *network;          /**< Neural network being trained */
+    int population;         /**< Number of candidates per generation, always even */
+    int threads;            /**< Number of worker threads */
+
+    double sigma;           /**< Standard deviation of the noise added to the weights */
+    double learningRate;    /**< Step size of the weight update */
+    uint64_t seed;          /**< Seed from which the noise of every generation is derived */
+    diwa_objective objective; /**< Per-sample objective, or NULL to use the network's loss */
+
+    double *arena;          /**< Single allocation holding every array below */
+    int arenaSize;          /**< Number of weights the arena was allocated for */
+
+    double *candidates;     /**< Weights of every candidate of the population */
+    double *noise;          /**< Noise of every antithetic candidate pair */
+    double *losses;         /**< Loss of every candidate */
+    double *scratch;        /**< Neuron outputs of every worker */
+    int *ranking;           /**< Candidate indices sorted by loss */
+
+    int generations;        /**< Number of generations run by the last call to evolve() */
+    double loss;            /**< Loss of the network after the last call to evolve() */
+
+    /**
+     * @brief Allocates the population arena for the network's size.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError allocate();
+
+    /**
+     * @brief Samples and scores the candidate pairs assigned to a worker.
+     *
+     * @param worker Index of the worker; it handles every pair whose index modulo
+     *        the number of threads equals this index.
+     * @param generation Index of the generation being sampled.
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     */
+    void evaluate(
+        int worker,
+        int generation,
+        const double *inputs,
+        const double *targets,
+        int samples
+    );
+
+    /**
+     * @brief Computes the mean loss of a weight vector over the dataset.
+     *
+     * @param weights Weights laid out like the network's weights.
+     * @param outputs Scratch array of at least `getNeuronCount()` elements.
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @return The mean loss over the dataset.
+     */
+    double score(
+        const double *weights,
+        double *outputs,
+        const double *inputs,
+        const double *targets,
+        int samples
+    ) const;
+
+public:
+    /**
+     * @brief Constructs an evolution strategies trainer for the given neural network.
+     *
+     * @param network The neural network to be trained. It must outlive the trainer.
+     * @param population Number of candidates per generation, rounded up to an even number (default is 32).
+     * @param threads Number of worker threads, or 0 to use every hardware thread (default is 0).
+     */
+    DiwaEvolution(Diwa& network, int population = 32, int threads = 0);
+
+    /**
+     * @brief Destructor for the DiwaEvolution class.
+     *
+     * Releases the population arena.
+     */
+    ~DiwaEvolution();
+
+    /**
+     * @brief Sets the standard deviation of the noise added to the weights.
+     *
+     * @param sigma The standard deviation of the noise (default is 0.1).
+     */
+    void setNoise(double sigma);
+
+    /**
+     * @brief Sets the step size of the weight update.
+     *
+     * @param learningRate The step size (default is 0.05).
+     */
+    void setLearningRate(double learningRate);
+
+    /**
+     * @brief Sets the seed from which the noise is derived.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Sets the per-sample objective to be minimized.
+     *
+     * @param objective The objective function, or NULL to minimize the loss of the
+     *        network's output mode (half the squared error, or the cross-entropy).
+     */
+    void setObjective(diwa_objective objective);
+
+    /**
+     * @brief Evolves the weights of the network over a dataset.
+     *
+     * This method runs generations until the loss of the network's weights reaches the
+     * target loss or the maximum number of generations is reached. When it returns, the
+     * network holds the best weights found among the final weights and the candidates of
+     * the last generation. Like Diwa::train(), it neither perturbs nor updates the weights
+     * of the layers frozen with Diwa::setLayerTrainable() and of the layers below them.
+     *
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @param generations Maximum number of generations.
+     * @param targetLoss Loss at which to stop, or 0 to run every generation.
+     *
+     * @return DiwaError indicating the training status.
+     */
+    DiwaError evolve(
+        const double *inputs,
+        const double *targets,
+        int samples,
+        int generations,
+        double targetLoss
+    );
+
+    /**
+     * @brief Get the number of generations run by the last evolution.
+     *
+     * @return The number of generations.
+     */
+    int getGenerations() const;
+
+    /**
+     * @brief Get the loss of the network after the last evolution.
+     *
+     * @return The mean objective over the dataset.
+     */
+    double getLoss() const;
+};
+
+#endif  // DIWA_EVOLUTION_H
@@ -0,0 +1,351 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_fixed.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DIWA_FIXED_SHIFT DIWA_FIXED_FRACTION_BITS       /**< Shift of the fixed-point format */
+#define DIWA_FIXED_TABLE_SHIFT (DIWA_FIXED_SHIFT - 3)   /**< Shift of the sigmoid table's step of 1/8 */
+
+/**
+ * @brief Sigmoid sampled in Q16.16 from -8 to 8 with a step of 1/8.
+ */
+static const int32_t sigmoidTable[129] = {
+    22, 25, 28, 32, 36, 41, 47, 53,
+    60, 68, 77, 87, 98, 111, 126, 143,
+    162, 184, 208, 236, 267, 302, 342, 387,
+    439, 497, 562, 636, 720, 815, 922, 1042,
+    1179, 1333, 1506, 1701, 1921, 2168, 2446, 2758,
+    3108, 3500, 3938, 4427, 4971, 5577, 6249, 6992,
+    7812, 8714, 9702, 10782, 11955, 13226, 14595, 16062,
+    17625, 19282, 21025, 22849, 24743, 26695, 28693, 30723,
+    32768, 34813, 36843, 38841, 40793, 42687, 44511, 46254,
+    47911, 49474, 50941, 52310, 53581, 54754, 55834, 56822,
+    57724, 58544, 59287, 59959, 60565, 61109, 61598, 62036,
+    62428, 62778, 63090, 63368, 63615, 63835, 64030, 64203,
+    64357, 64494, 64614, 64721, 64816, 64900, 64974, 65039,
+    65097, 65149, 65194, 65234, 65269, 65300, 65328, 65352,
+    65374, 65393, 65410, 65425, 65438, 65449, 65459, 65468,
+    65476, 65483, 65489, 65495, 65500, 65504, 65508, 65511,
+    65514
+};
+
+static inline diwa_fixed saturate(int64_t value) {
+    if(value > INT32_MAX)
+        return INT32_MAX;
+    else if(value < INT32_MIN)
+        return INT32_MIN;
+
+    return (diwa_fixed) value;
+}
+
+static inline diwa_fixed sigmoid(diwa_fixed x) {
+    const int64_t position = (int64_t) x + 8 * (int64_t) DIWA_FIXED_ONE;
+    int32_t y;
+
+    if(position <= 0)
+        y = sigmoidTable[0];
+    else if(position >= 16 * (int64_t) DIWA_FIXED_ONE)
+        y = sigmoidTable[128];
+    else {
+        const int index = (int) (position >> DIWA_FIXED_TABLE_SHIFT);
+        const int64_t fraction = position - ((int64_t) index << DIWA_FIXED_TABLE_SHIFT);
+
+        y = sigmoidTable[index] + (int32_t) (
+            ((sigmoidTable[index + 1] - sigmoidTable[index]) * fraction) >>
+            DIWA_FIXED_TABLE_SHIFT
+        );
+    }
+
+    #if DIWA_FIXED_SHIFT >= 16
+    return y << (DIWA_FIXED_SHIFT - 16);
+    #else
+    return y >> (16 - DIWA_FIXED_SHIFT);
+    #endif
+}
+
+DiwaFixed::DiwaFixed() {
+    this->inputNeurons = 0;
+    this->hiddenNeurons = 0;
+    this->hiddenLayers = 0;
+    this->outputNeurons = 0;
+
+    this->weightCount = 0;
+    this->neuronCount = 0;
+
+    this->weights = NULL;
+    this->outputs = NULL;
+    this->deltas = NULL;
+
+    this->stochasticRounding = true;
+}
+
+DiwaFixed::~DiwaFixed() {
+    free(this->weights);
+}
+
+DiwaError DiwaFixed::allocate(
+    int inputNeurons,
+    int hiddenLayers,
+    int hiddenNeurons,
+    int outputNeurons
+) {
+    const int weightCount = hiddenLayers ?
+        (inputNeurons + 1) * hiddenNeurons +
+            (hiddenLayers - 1) * (hiddenNeurons + 1) * hiddenNeurons +
+            (hiddenNeurons + 1) * outputNeurons :
+        (inputNeurons + 1) * outputNeurons;
+    const int neuronCount = inputNeurons + hiddenNeurons * hiddenLayers + outputNeurons;
+
+    diwa_fixed *weights = (diwa_fixed*) realloc(
+        this->weights,
+        sizeof(diwa_fixed) * (weightCount + 2 * neuronCount)
+    );
+    if(weights == NULL)
+        return MALLOC_FAILED;
+
+    this->inputNeurons = inputNeurons;
+    this->hiddenLayers = hiddenLayers;
+    this->hiddenNeurons = hiddenNeurons;
+    this->outputNeurons = outputNeurons;
+
+    this->weightCount = weightCount;
+    this->neuronCount = neuronCount;
+
+    this->weights = weights;
+    this->outputs = weights + weightCount;
+    this->deltas = this->outputs + neuronCount;
+
+    return NO_ERROR;
+}
+
+diwa_fixed DiwaFixed::rescale(int64_t value, bool stochastic) {
+    const int64_t mask = ((int64_t) 1 << DIWA_FIXED_SHIFT) - 1;
+    const int64_t offset = stochastic ?
+        (int64_t) (this->randomizer.next() >> 32) & mask :
+        (int64_t) 1 << (DIWA_FIXED_SHIFT - 1);
+
+    return saturate((value + offset) >> DIWA_FIXED_SHIFT);
+}
+
+DiwaError DiwaFixed::importNetwork(const Diwa& network) {
+    if(network.activation != DiwaActivationFunc::sigmoid ||
+        network.outputMode != ACTIVATION_OUTPUT ||
+        network.weightCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = this->allocate(
+        network.inputNeurons,
+        network.hiddenLayers,
+        network.hiddenNeurons,
+        network.outputNeurons
+    )) != NO_ERROR)
+        return error;
+
+    for(int i = 0; i < this->weightCount; i++)
+        this->weights[i] = DiwaFixed::toFixed(network.weights[i]);
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaFixed::exportNetwork(Diwa& network) const {
+    if(this->weightCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = network.initialize(
+        this->inputNeurons,
+        this->hiddenLayers,
+        this->hiddenNeurons,
+        this->outputNeurons,
+        false
+    )) != NO_ERROR)
+        return error;
+
+    network.setActivationFunction(DiwaActivationFunc::sigmoid);
+    network.setOutputMode(ACTIVATION_OUTPUT);
+
+    for(int i = 0; i < this->weightCount; i++)
+        network.weights[i] = DiwaFixed::toDouble(this->weights[i]);
+
+    return NO_ERROR;
+}
+
+diwa_fixed* DiwaFixed::forwardPass(const diwa_fixed *inputNeurons) {
+    memcpy(this->outputs, inputNeurons, sizeof(diwa_fixed) * this->inputNeurons);
+
+    const diwa_fixed *weights = this->weights;
+    const diwa_fixed *inputs = this->outputs;
+    diwa_fixed *outputs = this->outputs + this->inputNeurons;
+    diwa_fixed *derivatives = this->deltas;
+    int inputCount = this->inputNeurons;
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        const int outputCount = h < this->hiddenLayers ?
+            this->hiddenNeurons : this->outputNeurons;
+
+        for(int j = 0; j < outputCount; ++j) {
+            int64_t sum = -((int64_t) *weights++ << DIWA_FIXED_SHIFT);
+
+            for(int k = 0; k < inputCount; ++k)
+                sum += (int64_t) *weights++ * inputs[k];
+
+            const diwa_fixed output = sigmoid(this->rescale(sum, false));
+            outputs[j] = output;
+            derivatives[j] = this->rescale(
+                (int64_t) output * (DIWA_FIXED_ONE - output),
+                false
+            );
+        }
+
+        inputs = outputs;
+        outputs += outputCount;
+        derivatives += outputCount;
+        inputCount = outputCount;
+    }
+
+    return this->outputs + this->neuronCount - this->outputNeurons;
+}
+
+diwa_fixed* DiwaFixed::inference(const diwa_fixed *inputNeurons) {
+    if(this->weights == NULL)
+        return NULL;
+
+    return this->forwardPass(inputNeurons);
+}
+
+diwa_fixed DiwaFixed::train(
+    diwa_fixed learningRate,
+    const diwa_fixed *inputNeurons,
+    const diwa_fixed *outputNeurons
+) {
+    if(this->weights == NULL)
+        return 0;
+
+    const diwa_fixed *outputs = this->forwardPass(inputNeurons);
+    int64_t loss = 0;
+
+    {
+        diwa_fixed *deltas = this->deltas + this->hiddenNeurons * this->hiddenLayers;
+
+        for(int j = 0; j < this->outputNeurons; ++j) {
+            const diwa_fixed error = outputNeurons[j] - outputs[j];
+
+            deltas[j] = this->rescale((int64_t) deltas[j] * error, false);
+            loss += (int64_t) error * error;
+        }
+    }
+
+    for(int h = this->hiddenLayers - 1; h >= 0; --h) {
+        diwa_fixed *deltas = this->deltas + h * this->hiddenNeurons;
+        const diwa_fixed *forwardDeltas = deltas + this->hiddenNeurons;
+        const diwa_fixed *forwardWeights = this->weights +
+            (this->inputNeurons + 1) * this->hiddenNeurons +
+            (this->hiddenNeurons + 1) * this->hiddenNeurons * h;
+
+        const int forwardCount = h == this->hiddenLayers - 1 ?
+            this->outputNeurons : this->hiddenNeurons;
+
+        for(int j = 0; j < this->hiddenNeurons; ++j) {
+            int64_t sum = 0;
+
+            for(int k = 0; k < forwardCount; ++k)
+                sum += (int64_t) forwardDeltas[k] *
+                    forwardWeights[k * (this->hiddenNeurons + 1) + (j + 1)];
+
+            deltas[j] = this->rescale(
+                (int64_t) deltas[j] * this->rescale(sum, false),
+                false
+            );
+        }
+    }
+
+    diwa_fixed *weights = this->weights;
+    const diwa_fixed *inputs = this->outputs;
+    const diwa_fixed *deltas = this->deltas;
+    int inputCount = this->inputNeurons;
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        const int outputCount = h < this->hiddenLayers ?
+            this->hiddenNeurons : this->outputNeurons;
+
+        for(int j = 0; j < outputCount; ++j) {
+            const diwa_fixed step = this->rescale(
+                (int64_t) learningRate * deltas[j],
+                this->stochasticRounding
+            );
+
+            *weights = saturate((int64_t) *weights - step);
+            weights++;
+
+            for(int k = 0; k < inputCount; ++k, ++weights)
+                *weights = saturate((int64_t) *weights + this->rescale(
+                    (int64_t) step * inputs[k],
+                    this->stochasticRounding
+                ));
+        }
+
+        inputs += inputCount;
+        deltas += outputCount;
+        inputCount = outputCount;
+    }
+
+    return saturate(loss >> (DIWA_FIXED_SHIFT + 1));
+}
+
+void DiwaFixed::setStochasticRounding(bool stochastic) {
+    this->stochasticRounding = stochastic;
+}
+
+void DiwaFixed::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+}
+
+int DiwaFixed::getInputNeurons() const {
+    return this->inputNeurons;
+}
+
+int DiwaFixed::getOutputNeurons() const {
+    return this->outputNeurons;
+}
+
+int DiwaFixed::getWeightCount() const {
+    return this->weightCount;
+}
+
+diwa_fixed DiwaFixed::toFixed(double value) {
+    value *= DIWA_FIXED_ONE;
+
+    if(value >= (double) INT32_MAX)
+        return INT32_MAX;
+    else if(value <= (double) INT32_MIN)
+        return INT32_MIN;
+
+    return (diwa_fixed) (value < 0 ? value - 0.5 : value + 0.5);
+}
+
+double DiwaFixed::toDouble(diwa_fixed value) {
+    return (double) value / DIWA_FIXED_ONE;
+}
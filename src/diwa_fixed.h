@@ -0,0 +1,237 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_fixed.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaFixed class, a fixed-point
+ *        counterpart of the Diwa neural network for boards without an FPU.
+ *
+ * The DiwaFixed class runs inference and training of a Diwa neural network entirely
+ * with integer arithmetic. Weights, neuron outputs and deltas are signed 32-bit fixed-point
+ * numbers with `DIWA_FIXED_FRACTION_BITS` fractional bits (Q16.16 by default), products are
+ * accumulated in 64-bit integers, and the sigmoid activation is evaluated by interpolating
+ * a lookup table. Weight updates use stochastic rounding, so updates smaller than the
+ * resolution of the format are applied with a probability proportional to their size
+ * instead of being rounded away.
+ *
+ * @note Networks are imported from and exported to the Diwa class, which reads and writes
+ *       the standard model file format. Only networks using the DiwaActivationFunc::sigmoid
+ *       activation and the ACTIVATION_OUTPUT mode can be converted.
+ */
+
+#ifndef DIWA_FIXED_H
+#define DIWA_FIXED_H
+
+#include <diwa.h>
+
+#ifndef DIWA_FIXED_FRACTION_BITS
+/**
+ * @brief Number of fractional bits of the fixed-point format.
+ *
+ * It can be defined before including this file, within 8 and 24 inclusive.
+ */
+#   define DIWA_FIXED_FRACTION_BITS 16
+#endif
+
+#if DIWA_FIXED_FRACTION_BITS < 8 || DIWA_FIXED_FRACTION_BITS > 24
+#   error "DIWA_FIXED_FRACTION_BITS must be within 8 and 24"
+#endif
+
+/**
+ * @brief Typedef for fixed-point values.
+ *
+ * A value `v` of this type represents the real number `v / DIWA_FIXED_ONE`.
+ */
+typedef int32_t diwa_fixed;
+
+#define DIWA_FIXED_ONE ((diwa_fixed) 1 << DIWA_FIXED_FRACTION_BITS) /**< The number 1 in fixed-point */
+
+/**
+ *
+ * @class DiwaFixed
+ * @brief Fixed-point neural network with integer-only
+ *        inference and training.
+ *
+ * The DiwaFixed class mirrors the layout of the Diwa class,
+ * with every weight of a neuron stored after its bias. Apart
+ * from the conversion helpers, none of its methods use floating
+ * point arithmetic.
+ *
+ */
+class DiwaFixed final {
+private:
+    int inputNeurons;       /**< Number of input neurons */
+    int hiddenNeurons;      /**< Number of neurons in each hidden layer */
+    int hiddenLayers;       /**< Number of hidden layers */
+    int outputNeurons;      /**< Number of output neurons */
+
+    int weightCount;        /**< Total number of weights */
+    int neuronCount;        /**< Total number of neurons */
+
+    diwa_fixed *weights;    /**< Weights, followed by the outputs and the deltas */
+    diwa_fixed *outputs;    /**< Outputs of every neuron */
+    diwa_fixed *deltas;     /**< Deltas of every hidden and output neuron */
+
+    DiwaRandom randomizer;  /**< Pseudo-random number generator used for stochastic rounding */
+    bool stochasticRounding; /**< Whether weight updates are stochastically rounded */
+
+    /**
+     * @brief Allocates the weights, outputs and deltas for the given topology.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError allocate(int inputNeurons, int hiddenLayers, int hiddenNeurons, int outputNeurons);
+
+    /**
+     * @brief Shifts a 64-bit product right, rounding it to the nearest or stochastically.
+     *
+     * @param value The value to be shifted.
+     * @param stochastic Whether to round stochastically instead of to the nearest.
+     * @return The rounded and saturated fixed-point value.
+     */
+    diwa_fixed rescale(int64_t value, bool stochastic);
+
+    /**
+     * @brief Performs forward propagation and stores the activation derivatives in the deltas.
+     *
+     * @param inputNeurons Array of input values.
+     * @return Pointer to the output values of the output layer.
+     */
+    diwa_fixed* forwardPass(const diwa_fixed *inputNeurons);
+
+public:
+    /**
+     * @brief Default constructor for the DiwaFixed class.
+     *
+     * The network is empty until a Diwa network is imported.
+     */
+    DiwaFixed();
+
+    /**
+     * @brief Destructor for the DiwaFixed class.
+     *
+     * Releases the weights, outputs and deltas.
+     */
+    ~DiwaFixed();
+
+    /**
+     * @brief Imports the topology and weights of a Diwa neural network.
+     *
+     * Weights out of the range of the fixed-point format are saturated.
+     *
+     * @param network The neural network to be converted.
+     * @return DiwaError::INVALID_PARAM_VALUES if the network does not use the sigmoid
+     *         activation with the ACTIVATION_OUTPUT mode, or the allocation status.
+     */
+    DiwaError importNetwork(const Diwa& network);
+
+    /**
+     * @brief Exports the topology and weights into a Diwa neural network.
+     *
+     * The network is reinitialized with the topology of this network, the sigmoid activation
+     * and the ACTIVATION_OUTPUT mode, so it can be saved into the standard model file format.
+     *
+     * @param network The neural network receiving the weights.
+     * @return DiwaError indicating the export status.
+     */
+    DiwaError exportNetwork(Diwa& network) const;
+
+    /**
+     * @brief Performs inference on the fixed-point network.
+     *
+     * @param inputNeurons Array of fixed-point input values.
+     * @return Pointer to the fixed-point output values, owned by the network.
+     */
+    diwa_fixed* inference(const diwa_fixed *inputNeurons);
+
+    /**
+     * @brief Trains the fixed-point network on a single sample.
+     *
+     * This method performs a forward pass, backpropagates half the squared error, and
+     * updates the weights with the given learning rate using integer arithmetic only.
+     *
+     * @param learningRate Fixed-point learning rate.
+     * @param inputNeurons Array of fixed-point input values.
+     * @param outputNeurons Array of fixed-point target values.
+     * @return The fixed-point loss of the sample before the update.
+     */
+    diwa_fixed train(
+        diwa_fixed learningRate,
+        const diwa_fixed *inputNeurons,
+        const diwa_fixed *outputNeurons
+    );
+
+    /**
+     * @brief Sets whether weight updates are stochastically rounded.
+     *
+     * @param stochastic True to round stochastically (default), false to round to the nearest.
+     */
+    void setStochasticRounding(bool stochastic);
+
+    /**
+     * @brief Seeds the pseudo-random number generator used for stochastic rounding.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Get the number of input neurons in the network.
+     *
+     * @return Number of input neurons.
+     */
+    int getInputNeurons() const;
+
+    /**
+     * @brief Get the number of output neurons in the network.
+     *
+     * @return Number of output neurons.
+     */
+    int getOutputNeurons() const;
+
+    /**
+     * @brief Get the total number of weights in the network.
+     *
+     * @return Total number of weights.
+     */
+    int getWeightCount() const;
+
+    /**
+     * @brief Converts a real number into fixed-point, saturating it to the range of the format.
+     *
+     * @param value The value to be converted.
+     * @return The nearest fixed-point value.
+     */
+    static diwa_fixed toFixed(double value);
+
+    /**
+     * @brief Converts a fixed-point value into a real number.
+     *
+     * @param value The fixed-point value to be converted.
+     * @return The real number represented by the value.
+     */
+    static double toDouble(diwa_fixed value);
+};
+
+#endif  // DIWA_FIXED_H
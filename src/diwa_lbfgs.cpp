@@ -0,0 +1,217 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_lbfgs.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DIWA_LBFGS_ARMIJO           1e-4    /**< Sufficient decrease constant of the line search */
+#define DIWA_LBFGS_MAX_BACKTRACKS   20      /**< Maximum number of step halvings per iteration */
+#define DIWA_LBFGS_EPSILON          1e-10   /**< Threshold below which a quantity counts as zero */
+
+static inline double dot(const double *a, const double *b, int count) {
+    double sum = 0;
+
+    for(int i = 0; i < count; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+DiwaLBFGS::DiwaLBFGS(Diwa& network, int history) {
+    this->network = &network;
+    this->history = history > 0 ? history : 1;
+
+    this->buffer = NULL;
+    this->bufferSize = 0;
+
+    this->iterations = 0;
+    this->evaluations = 0;
+    this->loss = 0;
+}
+
+DiwaLBFGS::~DiwaLBFGS() {
+    free(this->buffer);
+}
+
+DiwaError DiwaLBFGS::allocate() {
+    const int count = this->network->weightCount;
+    if(this->buffer != NULL && this->bufferSize == count)
+        return NO_ERROR;
+
+    free(this->buffer);
+    this->buffer = (double*) malloc(
+        sizeof(double) * ((4 + 2 * this->history) * count + 2 * this->history)
+    );
+
+    if(this->buffer == NULL) {
+        this->bufferSize = 0;
+        return MALLOC_FAILED;
+    }
+
+    this->bufferSize = count;
+    this->gradient = this->buffer;
+    this->nextGradient = this->gradient + count;
+    this->direction = this->nextGradient + count;
+    this->previous = this->direction + count;
+    this->steps = this->previous + count;
+    this->changes = this->steps + this->history * count;
+    this->rho = this->changes + this->history * count;
+    this->alpha = this->rho + this->history;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaLBFGS::minimize(
+    double *inputs,
+    double *targets,
+    int samples,
+    int maxIterations,
+    double targetLoss
+) {
+    if(samples <= 0 || maxIterations <= 0 ||
+        this->network->weightCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    DiwaError error;
+    if((error = this->allocate()) != NO_ERROR)
+        return error;
+
+    // Only the trainable weights take part in the optimization, so the
+    // frozen ones are never moved by the line search
+    const int offset = this->network->getTrainableOffset();
+    const int count = this->network->weightCount - offset;
+    double *weights = this->network->weights + offset;
+
+    this->loss = this->network->calculateGradient(inputs, targets, samples, this->gradient);
+    this->evaluations = 1;
+
+    int stored = 0, newest = -1;
+    for(this->iterations = 0; this->iterations < maxIterations; this->iterations++) {
+        if(this->loss <= targetLoss)
+            break;
+
+        const double *gradient = this->gradient + offset;
+        const double gradientNorm = sqrt(dot(gradient, gradient, count));
+        if(gradientNorm < DIWA_LBFGS_EPSILON)
+            break;
+
+        for(int i = 0; i < count; i++)
+            this->direction[i] = -gradient[i];
+
+        for(int n = 0, m = newest; n < stored; n++) {
+            this->alpha[m] = this->rho[m] * dot(this->steps + m * count, this->direction, count);
+
+            for(int i = 0; i < count; i++)
+                this->direction[i] -= this->alpha[m] * this->changes[m * count + i];
+            m = (m + this->history - 1) % this->history;
+        }
+
+        if(stored) {
+            double *change = this->changes + newest * count;
+            const double scale = 1.0 / (this->rho[newest] * dot(change, change, count));
+
+            for(int i = 0; i < count; i++)
+                this->direction[i] *= scale;
+        }
+
+        for(int n = 0, m = (newest + this->history - stored + 1) % this->history; n < stored; n++) {
+            const double beta = this->rho[m] * dot(this->changes + m * count, this->direction, count);
+
+            for(int i = 0; i < count; i++)
+                this->direction[i] += (this->alpha[m] - beta) * this->steps[m * count + i];
+            m = (m + 1) % this->history;
+        }
+
+        double slope = dot(gradient, this->direction, count);
+        if(slope >= 0) {
+            for(int i = 0; i < count; i++)
+                this->direction[i] = -gradient[i];
+
+            slope = -gradientNorm * gradientNorm;
+            stored = 0;
+        }
+
+        memcpy(this->previous, weights, sizeof(double) * count);
+        double step = stored ? 1.0 : 1.0 / gradientNorm, nextLoss = 0;
+
+        int backtracks = 0;
+        for(; backtracks < DIWA_LBFGS_MAX_BACKTRACKS; backtracks++, step *= 0.5) {
+            for(int i = 0; i < count; i++)
+                weights[i] = this->previous[i] + step * this->direction[i];
+
+            nextLoss = this->network->calculateGradient(
+                inputs, targets, samples,
+                this->nextGradient
+            );
+            this->evaluations++;
+
+            if(nextLoss <= this->loss + DIWA_LBFGS_ARMIJO * step * slope)
+                break;
+        }
+
+        if(backtracks == DIWA_LBFGS_MAX_BACKTRACKS) {
+            memcpy(weights, this->previous, sizeof(double) * count);
+            break;
+        }
+
+        const int slot = (newest + 1) % this->history;
+        double *stepDiff = this->steps + slot * count;
+        double *gradientDiff = this->changes + slot * count;
+
+        for(int i = 0; i < count; i++) {
+            stepDiff[i] = weights[i] - this->previous[i];
+            gradientDiff[i] = this->nextGradient[offset + i] - gradient[i];
+        }
+
+        const double curvature = dot(stepDiff, gradientDiff, count);
+        if(curvature > DIWA_LBFGS_EPSILON) {
+            this->rho[slot] = 1.0 / curvature;
+            newest = slot;
+
+            if(stored < this->history)
+                stored++;
+        }
+        else if(stored == this->history)
+            stored--;
+
+        double *swap = this->gradient;
+        this->gradient = this->nextGradient;
+        this->nextGradient = swap;
+        this->loss = nextLoss;
+    }
+
+    this->network->reducedStale = true;
+    return NO_ERROR;
+}
+
+int DiwaLBFGS::getIterations() const {
+    return this->iterations;
+}
+
+int DiwaLBFGS::getEvaluations() const {
+    return this->evaluations;
+}
+
+double DiwaLBFGS::getLoss() const {
+    return this->loss;
+}
@@ -0,0 +1,153 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_lbfgs.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaLBFGS class, a full-batch
+ *        second-order trainer for the Diwa neural network.
+ *
+ * The DiwaLBFGS class minimizes the loss of a Diwa neural network over a whole dataset
+ * using the limited-memory Broyden–Fletcher–Goldfarb–Shanno (L-BFGS) method. It builds
+ * an approximation of the inverse Hessian from the last few gradient differences, which
+ * lets small networks with modest datasets converge in far fewer passes over the data
+ * than stochastic gradient descent with Diwa::train().
+ *
+ * @note Every iteration computes the exact gradient over the whole dataset, and the
+ *       trainer keeps `2 * history + 4` arrays as large as the weights of the network.
+ *       It is intended for networks of up to a few thousand weights.
+ */
+
+#ifndef DIWA_LBFGS_H
+#define DIWA_LBFGS_H
+
+#include <diwa.h>
+
+/**
+ *
+ * @class DiwaLBFGS
+ * @brief Full-batch L-BFGS trainer for the Diwa neural network.
+ *
+ * The DiwaLBFGS class updates the weights array of the
+ * network in place. Each iteration computes a search
+ * direction with the L-BFGS two-loop recursion and picks
+ * the step length with a backtracking line search satisfying
+ * the Armijo condition.
+ *
+ */
+class DiwaLBFGS final {
+private:
+    Diwa *network;      /**< Neural network being trained */
+    int history;        /**< Number of correction pairs kept */
+
+    double *buffer;     /**< Single allocation holding every array below */
+    int bufferSize;     /**< Number of weights the buffer was allocated for */
+
+    double *gradient;       /**< Gradient at the current weights */
+    double *nextGradient;   /**< Gradient at the trial weights */
+    double *direction;      /**< Search direction */
+    double *previous;       /**< Weights before the current step */
+    double *steps;          /**< History of weight differences */
+    double *changes;        /**< History of gradient differences */
+    double *rho;            /**< Reciprocal curvature of each correction pair */
+    double *alpha;          /**< Scratch coefficients of the two-loop recursion */
+
+    int iterations;     /**< Number of iterations run by the last minimization */
+    int evaluations;    /**< Number of full-batch gradient evaluations */
+    double loss;        /**< Loss reached by the last minimization */
+
+    /**
+     * @brief Allocates the arrays of the trainer for the network's weight count.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError allocate();
+
+public:
+    /**
+     * @brief Constructs an L-BFGS trainer for the given neural network.
+     *
+     * @param network The neural network to be trained. It must outlive the trainer.
+     * @param history Number of correction pairs kept to approximate the inverse Hessian (default is 8).
+     */
+    DiwaLBFGS(Diwa& network, int history = 8);
+
+    /**
+     * @brief Destructor for the DiwaLBFGS class.
+     *
+     * Releases the arrays allocated by the trainer.
+     */
+    ~DiwaLBFGS();
+
+    /**
+     * @brief Minimizes the loss of the network over a dataset.
+     *
+     * This method iterates until the mean loss over the dataset reaches the target loss,
+     * the gradient vanishes, the line search cannot decrease the loss anymore, or the
+     * maximum number of iterations is reached. The loss minimized is the one of the
+     * network's output mode, as returned by Diwa::calculateGradient(). Like Diwa::train(),
+     * it leaves the weights of the layers frozen with Diwa::setLayerTrainable() and of the
+     * layers below them unchanged.
+     *
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @param maxIterations Maximum number of iterations.
+     * @param targetLoss Loss at which to stop, or 0 to run until convergence.
+     *
+     * @return DiwaError indicating the training status.
+     */
+    DiwaError minimize(
+        double *inputs,
+        double *targets,
+        int samples,
+        int maxIterations,
+        double targetLoss
+    );
+
+    /**
+     * @brief Get the number of iterations run by the last minimization.
+     *
+     * @return The number of iterations.
+     */
+    int getIterations() const;
+
+    /**
+     * @brief Get the number of full-batch gradient evaluations of the last minimization.
+     *
+     * Each evaluation is one pass over the dataset, which makes this the figure to compare
+     * with the number of epochs needed by stochastic gradient descent.
+     *
+     * @return The number of gradient evaluations, including line search trials.
+     */
+    int getEvaluations() const;
+
+    /**
+     * @brief Get the loss reached by the last minimization.
+     *
+     * @return The mean loss over the dataset.
+     */
+    double getLoss() const;
+};
+
+#endif  // DIWA_LBFGS_H
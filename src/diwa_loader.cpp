@@ -0,0 +1,263 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_loader.h>
+
+#ifdef DIWA_THREADS
+
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+typedef std::chrono::steady_clock diwa_clock;
+
+static inline double secondsSince(diwa_clock::time_point start) {
+    return std::chrono::duration<double>(diwa_clock::now() - start).count();
+}
+
+DiwaLoader::DiwaLoader(DiwaDataset& dataset) {
+    this->dataset = &dataset;
+    this->transform = NULL;
+
+    this->batchSize = 0;
+    this->depth = 0;
+    this->buffers = NULL;
+    this->counts = NULL;
+
+    this->head = 0;
+    this->tail = 0;
+    this->filled = 0;
+    this->held = false;
+    this->finished = true;
+    this->stopping = false;
+
+    this->stallTime = 0;
+    this->loadTime = 0;
+}
+
+DiwaLoader::~DiwaLoader() {
+    this->stop();
+
+    free(this->buffers);
+    free(this->counts);
+}
+
+void DiwaLoader::setTransform(diwa_transform transform) {
+    this->transform = transform;
+}
+
+DiwaError DiwaLoader::start(int batchSize, int depth, int epochs) {
+    if(batchSize <= 0 || depth < 2 || epochs <= 0 ||
+        this->dataset->getSampleCount() <= 0)
+        return INVALID_PARAM_VALUES;
+
+    this->stop();
+
+    const int sampleSize = this->dataset->getInputCount() +
+        this->dataset->getTargetCount();
+
+    double *buffers = (double*) realloc(
+        this->buffers,
+        sizeof(double) * depth * batchSize * sampleSize
+    );
+    if(buffers == NULL)
+        return MALLOC_FAILED;
+    this->buffers = buffers;
+
+    int *counts = (int*) realloc(this->counts, sizeof(int) * depth);
+    if(counts == NULL)
+        return MALLOC_FAILED;
+    this->counts = counts;
+
+    this->batchSize = batchSize;
+    this->depth = depth;
+
+    this->head = 0;
+    this->tail = 0;
+    this->filled = 0;
+    this->held = false;
+    this->finished = false;
+    this->stopping = false;
+
+    this->stallTime = 0;
+    this->loadTime = 0;
+
+    this->worker = std::thread(&DiwaLoader::run, this, epochs);
+    return NO_ERROR;
+}
+
+void DiwaLoader::stop() {
+    if(!this->worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->stopping = true;
+    }
+
+    this->freed.notify_all();
+    this->worker.join();
+
+    this->filled = 0;
+    this->held = false;
+    this->finished = true;
+}
+
+void DiwaLoader::run(int epochs) {
+    const int inputCount = this->dataset->getInputCount();
+    const int targetCount = this->dataset->getTargetCount();
+    const int samples = this->dataset->getSampleCount();
+    const int slotSize = this->batchSize * (inputCount + targetCount);
+
+    for(int epoch = 0; epoch < epochs; epoch++) {
+        diwa_clock::time_point start = diwa_clock::now();
+        this->dataset->shuffle();
+        double elapsed = secondsSince(start);
+
+        for(int first = 0;; first += this->batchSize) {
+            {
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->freed.wait(guard, [this]() {
+                    return this->stopping || this->filled < this->depth;
+                });
+
+                if(this->stopping)
+                    return;
+            }
+
+            start = diwa_clock::now();
+
+            const int count = first >= samples ? 0 :
+                samples - first < this->batchSize ? samples - first : this->batchSize;
+            double *inputs = this->buffers + this->head * slotSize;
+            double *targets = inputs + this->batchSize * inputCount;
+
+            for(int i = 0; i < count; i++) {
+                double *sampleInputs = inputs + i * inputCount;
+                double *sampleTargets = targets + i * targetCount;
+
+                memcpy(sampleInputs, this->dataset->getSampleInputs(first + i),
+                    sizeof(double) * inputCount);
+                memcpy(sampleTargets, this->dataset->getSampleTargets(first + i),
+                    sizeof(double) * targetCount);
+
+                if(this->transform != NULL)
+                    this->transform(sampleInputs, inputCount, sampleTargets, targetCount);
+            }
+
+            elapsed += secondsSince(start);
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+
+                this->counts[this->head] = count;
+                this->head = (this->head + 1) % this->depth;
+                this->filled++;
+                this->loadTime += elapsed;
+            }
+
+            this->ready.notify_one();
+            elapsed = 0;
+
+            if(count == 0)
+                break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->finished = true;
+    }
+    this->ready.notify_one();
+}
+
+int DiwaLoader::next(double **inputs, double **targets) {
+    std::unique_lock<std::mutex> guard(this->lock);
+
+    if(this->held) {
+        this->tail = (this->tail + 1) % this->depth;
+        this->filled--;
+        this->held = false;
+
+        this->freed.notify_one();
+    }
+
+    if(this->filled == 0 && !this->finished) {
+        diwa_clock::time_point start = diwa_clock::now();
+
+        this->ready.wait(guard, [this]() {
+            return this->filled > 0 || this->finished;
+        });
+        this->stallTime += secondsSince(start);
+    }
+
+    if(this->filled == 0)
+        return -1;
+
+    const int slotSize = this->batchSize *
+        (this->dataset->getInputCount() + this->dataset->getTargetCount());
+
+    *inputs = this->buffers + this->tail * slotSize;
+    *targets = *inputs + this->batchSize * this->dataset->getInputCount();
+    this->held = true;
+
+    return this->counts[this->tail];
+}
+
+double DiwaLoader::train(Diwa& network, double learningRate) {
+    const int inputCount = this->dataset->getInputCount();
+    const int targetCount = this->dataset->getTargetCount();
+
+    if(network.getInputNeurons() != inputCount ||
+        network.getOutputNeurons() != targetCount)
+        return -1;
+
+    double loss = 0, *inputs, *targets;
+    int count, samples = 0;
+
+    while((count = this->next(&inputs, &targets)) > 0) {
+        for(int i = 0; i < count; i++)
+            loss += network.train(
+                learningRate,
+                inputs + i * inputCount,
+                targets + i * targetCount
+            );
+
+        samples += count;
+    }
+
+    if(count < 0 && samples == 0)
+        return -1;
+    return loss / samples;
+}
+
+double DiwaLoader::getStallTime() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->stallTime;
+}
+
+double DiwaLoader::getLoadTime() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->loadTime;
+}
+
+#endif
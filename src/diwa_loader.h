@@ -0,0 +1,192 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_loader.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaLoader class, which prepares
+ *        the mini-batches of a dataset in the background while the network trains.
+ *
+ * The DiwaLoader class runs a loader thread that shuffles a DiwaDataset at the beginning of
+ * every epoch, gathers the samples of each mini-batch into a contiguous batch buffer and
+ * applies an optional transform (e.g. normalization or augmentation) to them. Batches are
+ * prepared up to a configurable prefetch depth ahead of the training thread, which only
+ * waits when the loader falls behind. The time spent waiting is reported as the stall time,
+ * which tells whether training is input-bound.
+ *
+ * @note This class is only available on desktop platforms.
+ */
+
+#ifndef DIWA_LOADER_H
+#define DIWA_LOADER_H
+
+#include <diwa.h>
+#include <diwa_dataset.h>
+
+#ifdef DIWA_THREADS
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Function pointer type for sample transforms.
+ *
+ * A transform is applied by the loader thread to every sample copied into a batch buffer,
+ * and may modify its input and target values in place.
+ *
+ * @param inputs Input values of the sample.
+ * @param inputCount Number of input values.
+ * @param targets Target values of the sample.
+ * @param targetCount Number of target values.
+ */
+typedef void (*diwa_transform)(double *inputs, int inputCount, double *targets, int targetCount);
+
+/**
+ *
+ * @class DiwaLoader
+ * @brief Asynchronous mini-batch loader with a
+ *        configurable prefetch depth.
+ *
+ * Each batch buffer holds the input values of its samples
+ * followed by their target values, both contiguous. The
+ * dataset belongs to the loader thread between start() and
+ * the end of the last epoch (or stop()), and must not be
+ * used in the meantime.
+ *
+ */
+class DiwaLoader final {
+private:
+    DiwaDataset *dataset;       /**< Dataset the batches are taken from */
+    diwa_transform transform;   /**< Transform applied to every sample, or NULL */
+
+    int batchSize;              /**< Maximum number of samples per batch */
+    int depth;                  /**< Number of batch buffers */
+    double *buffers;            /**< Batch buffers */
+    int *counts;                /**< Number of samples of every batch buffer, 0 marking the end of an epoch */
+
+    int head;                   /**< Next batch buffer to be filled by the loader thread */
+    int tail;                   /**< Next batch buffer to be consumed by the training thread */
+    int filled;                 /**< Number of batch buffers ready to be consumed */
+    bool held;                  /**< Whether the training thread holds the batch buffer at the tail */
+    bool finished;              /**< Whether the loader thread has prepared every epoch */
+    bool stopping;              /**< Whether the loader thread was asked to stop */
+
+    double stallTime;           /**< Seconds spent by the training thread waiting for batches */
+    double loadTime;            /**< Seconds spent by the loader thread preparing batches */
+
+    std::mutex lock;                /**< Lock protecting the state of the batch buffers */
+    std::condition_variable ready;  /**< Signaled when a batch buffer is filled */
+    std::condition_variable freed;  /**< Signaled when a batch buffer is released */
+    std::thread worker;             /**< Loader thread */
+
+    /**
+     * @brief Body of the loader thread.
+     *
+     * @param epochs Number of epochs to prepare.
+     */
+    void run(int epochs);
+
+public:
+    /**
+     * @brief Constructs a loader for the given dataset.
+     *
+     * @param dataset The dataset the batches are taken from. It must outlive the loader.
+     */
+    DiwaLoader(DiwaDataset& dataset);
+
+    /**
+     * @brief Destructor for the DiwaLoader class.
+     *
+     * Stops the loader thread and releases the batch buffers.
+     */
+    ~DiwaLoader();
+
+    /**
+     * @brief Sets the transform applied to every sample of the batches.
+     *
+     * @param transform The sample transform, or NULL to copy the samples unchanged.
+     */
+    void setTransform(diwa_transform transform);
+
+    /**
+     * @brief Starts the loader thread.
+     *
+     * @param batchSize Maximum number of samples per batch.
+     * @param depth Number of batch buffers, at least 2. The loader thread prepares up to
+     *        `depth - 1` batches ahead of the batch being trained on.
+     * @param epochs Number of epochs to prepare.
+     * @return DiwaError indicating the starting status.
+     */
+    DiwaError start(int batchSize, int depth, int epochs);
+
+    /**
+     * @brief Stops the loader thread.
+     *
+     * Batches not consumed yet are discarded.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the next batch.
+     *
+     * This method releases the batch returned by the previous call, then waits until the
+     * next batch is ready. The returned pointers stay valid until the next call.
+     *
+     * @param inputs Pointer receiving the contiguous input values of the batch.
+     * @param targets Pointer receiving the contiguous target values of the batch.
+     * @return The number of samples of the batch, 0 at the end of an epoch, or -1 once
+     *         every epoch has been consumed.
+     */
+    int next(double **inputs, double **targets);
+
+    /**
+     * @brief Trains the network for one epoch on the prepared batches.
+     *
+     * @param network The neural network to be trained.
+     * @param learningRate Learning rate for the training process.
+     * @return The mean loss of the epoch, or -1 if every epoch has been consumed.
+     */
+    double train(Diwa& network, double learningRate);
+
+    /**
+     * @brief Get the time spent waiting for batches.
+     *
+     * @return The number of seconds the training thread waited for the loader thread
+     *         since start(). A stall time close to the training time means that training
+     *         is input-bound.
+     */
+    double getStallTime();
+
+    /**
+     * @brief Get the time spent preparing batches.
+     *
+     * @return The number of seconds the loader thread spent shuffling, copying and
+     *         transforming samples since start().
+     */
+    double getLoadTime();
+};
+
+#endif
+
+#endif  // DIWA_LOADER_H
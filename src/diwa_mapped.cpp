@@ -0,0 +1,296 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_mapped.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+
+#include <diwa_conv.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DIWA_MAPPED_BLOCK_BYTES 262144 /**< Default size in bytes of the blocks */
+
+DiwaMappedDataset::DiwaMappedDataset() {
+    this->descriptor = -1;
+    this->mapping = NULL;
+    this->mappingSize = 0;
+    this->rows = NULL;
+
+    this->inputCount = 0;
+    this->targetCount = 0;
+    this->samples = 0;
+
+    this->blockSamples = 0;
+    this->blocks = NULL;
+}
+
+DiwaMappedDataset::~DiwaMappedDataset() {
+    this->close();
+}
+
+DiwaError DiwaMappedDataset::writeHeader(
+    std::ofstream& file,
+    int samples,
+    int inputCount,
+    int targetCount
+) {
+    if(!file.is_open())
+        return STREAM_NOT_OPEN;
+    else if(samples <= 0 || inputCount <= 0 || targetCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    uint8_t header[DIWA_MAPPED_HEADER_SIZE] = {'d', 'i', 'w', 'd'};
+    const int fields[3] = {inputCount, targetCount, samples};
+
+    for(int i = 0; i < 3; i++) {
+        uint8_t *bytes = DiwaConv::intToU8a(fields[i]);
+
+        memcpy(header + 4 + 4 * i, bytes, 4);
+        delete[] bytes;
+    }
+
+    file.write(reinterpret_cast<const char*>(header), DIWA_MAPPED_HEADER_SIZE);
+    return file ? NO_ERROR : MODEL_SAVE_ERROR;
+}
+
+DiwaError DiwaMappedDataset::writeSamples(
+    std::ofstream& file,
+    const double *inputs,
+    const double *targets,
+    int samples,
+    int inputCount,
+    int targetCount
+) {
+    if(!file.is_open())
+        return STREAM_NOT_OPEN;
+
+    for(int i = 0; i < samples; i++) {
+        file.write(
+            reinterpret_cast<const char*>(inputs + i * inputCount),
+            sizeof(double) * inputCount
+        );
+
+        file.write(
+            reinterpret_cast<const char*>(targets + i * targetCount),
+            sizeof(double) * targetCount
+        );
+    }
+
+    return file ? NO_ERROR : MODEL_SAVE_ERROR;
+}
+
+DiwaError DiwaMappedDataset::open(const char *path) {
+    this->close();
+
+    this->descriptor = ::open(path, O_RDONLY);
+    if(this->descriptor < 0)
+        return STREAM_NOT_OPEN;
+
+    struct stat status;
+    if(fstat(this->descriptor, &status) != 0 ||
+        status.st_size < DIWA_MAPPED_HEADER_SIZE) {
+        this->close();
+        return MODEL_READ_ERROR;
+    }
+
+    this->mapping = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, this->descriptor, 0);
+    if(this->mapping == MAP_FAILED) {
+        this->mapping = NULL;
+        this->close();
+
+        return MODEL_READ_ERROR;
+    }
+    this->mappingSize = status.st_size;
+
+    uint8_t *header = (uint8_t*) this->mapping;
+    if(memcmp(header, "diwd", 4) != 0) {
+        this->close();
+        return INVALID_MAGIC_NUMBER;
+    }
+
+    const int inputCount = DiwaConv::u8aToInt(header + 4);
+    const int targetCount = DiwaConv::u8aToInt(header + 8);
+    const int samples = DiwaConv::u8aToInt(header + 12);
+
+    if(inputCount <= 0 || targetCount <= 0 || samples <= 0 ||
+        (this->mappingSize - DIWA_MAPPED_HEADER_SIZE) /
+            (sizeof(double) * (inputCount + targetCount)) < (size_t) samples) {
+        this->close();
+        return MODEL_READ_ERROR;
+    }
+
+    madvise(this->mapping, this->mappingSize, MADV_SEQUENTIAL);
+
+    this->rows = (const double*) (header + DIWA_MAPPED_HEADER_SIZE);
+    this->inputCount = inputCount;
+    this->targetCount = targetCount;
+    this->samples = samples;
+
+    const int rowBytes = sizeof(double) * (inputCount + targetCount);
+    DiwaError error = this->setBlockSize(
+        rowBytes < DIWA_MAPPED_BLOCK_BYTES ? DIWA_MAPPED_BLOCK_BYTES / rowBytes : 1
+    );
+
+    if(error != NO_ERROR)
+        this->close();
+    return error;
+}
+
+void DiwaMappedDataset::close() {
+    if(this->mapping != NULL)
+        munmap(this->mapping, this->mappingSize);
+    if(this->descriptor >= 0)
+        ::close(this->descriptor);
+    free(this->blocks);
+
+    this->descriptor = -1;
+    this->mapping = NULL;
+    this->mappingSize = 0;
+    this->rows = NULL;
+
+    this->samples = 0;
+    this->blockSamples = 0;
+    this->blocks = NULL;
+}
+
+DiwaError DiwaMappedDataset::setBlockSize(int samples) {
+    if(samples <= 0 || this->rows == NULL)
+        return INVALID_PARAM_VALUES;
+
+    if(samples > this->samples)
+        samples = this->samples;
+
+    const int blockCount = (this->samples + samples - 1) / samples;
+    int *blocks = (int*) realloc(this->blocks, sizeof(int) * (blockCount + samples));
+
+    if(blocks == NULL)
+        return MALLOC_FAILED;
+
+    this->blocks = blocks;
+    this->blockSamples = samples;
+
+    return NO_ERROR;
+}
+
+void DiwaMappedDataset::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+}
+
+void DiwaMappedDataset::advise(int block, int advice) const {
+    static const uintptr_t page = (uintptr_t) sysconf(_SC_PAGESIZE);
+
+    const size_t rowBytes = sizeof(double) * (this->inputCount + this->targetCount);
+    const int first = block * this->blockSamples;
+    const int count = this->samples - first < this->blockSamples ?
+        this->samples - first : this->blockSamples;
+
+    const uintptr_t start = (uintptr_t) this->rows + first * rowBytes;
+    const uintptr_t aligned = start & ~(page - 1);
+
+    madvise((void*) aligned, start + count * rowBytes - aligned, advice);
+}
+
+double DiwaMappedDataset::train(Diwa& network, double learningRate) {
+    if(this->rows == NULL ||
+        network.getInputNeurons() != this->inputCount ||
+        network.getOutputNeurons() != this->targetCount)
+        return -1;
+
+    const int rowSize = this->inputCount + this->targetCount;
+    const int blockCount = (this->samples + this->blockSamples - 1) / this->blockSamples;
+    int *order = this->blocks, *local = this->blocks + blockCount;
+
+    for(int i = 0; i < blockCount; i++)
+        order[i] = i;
+
+    for(int i = blockCount - 1; i > 0; i--) {
+        const int j = (int) (this->randomizer.next() % (uint64_t) (i + 1));
+        const int block = order[i];
+
+        order[i] = order[j];
+        order[j] = block;
+    }
+
+    double loss = 0;
+    this->advise(order[0], MADV_WILLNEED);
+
+    for(int b = 0; b < blockCount; b++) {
+        if(b + 1 < blockCount)
+            this->advise(order[b + 1], MADV_WILLNEED);
+
+        const int first = order[b] * this->blockSamples;
+        const int count = this->samples - first < this->blockSamples ?
+            this->samples - first : this->blockSamples;
+
+        for(int i = 0; i < count; i++)
+            local[i] = i;
+
+        for(int i = count - 1; i > 0; i--) {
+            const int j = (int) (this->randomizer.next() % (uint64_t) (i + 1));
+            const int sample = local[i];
+
+            local[i] = local[j];
+            local[j] = sample;
+        }
+
+        for(int i = 0; i < count; i++) {
+            double *row = (double*) this->rows + (size_t) (first + local[i]) * rowSize;
+            loss += network.train(learningRate, row, row + this->inputCount);
+        }
+
+        this->advise(order[b], MADV_DONTNEED);
+    }
+
+    return loss / this->samples;
+}
+
+const double *DiwaMappedDataset::getInputs(int sample) const {
+    return this->rows + (size_t) sample * (this->inputCount + this->targetCount);
+}
+
+const double *DiwaMappedDataset::getTargets(int sample) const {
+    return this->getInputs(sample) + this->inputCount;
+}
+
+int DiwaMappedDataset::getSampleCount() const {
+    return this->samples;
+}
+
+int DiwaMappedDataset::getInputCount() const {
+    return this->inputCount;
+}
+
+int DiwaMappedDataset::getTargetCount() const {
+    return this->targetCount;
+}
+
+int DiwaMappedDataset::getBlockSize() const {
+    return this->blockSamples;
+}
+
+#endif
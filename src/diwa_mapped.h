@@ -0,0 +1,224 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_mapped.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaMappedDataset class, which
+ *        streams datasets larger than the memory from memory-mapped files.
+ *
+ * The DiwaMappedDataset class trains a Diwa neural network on a binary dataset file without
+ * ever loading the whole file. The file is mapped into memory read-only, and every epoch
+ * visits it block by block: the order of the blocks is shuffled, then the samples within
+ * each block are shuffled. Consecutive samples thus stay within a few pages of each other,
+ * while the network still sees the samples in a different order on every epoch. The kernel
+ * is advised to read the next block ahead while the current one is trained on, and to drop
+ * the pages of the blocks already trained on.
+ *
+ * A dataset file starts with a header of 64 bytes holding the magic number `diwd`, the
+ * number of input values, the number of target values and the number of samples as 32-bit
+ * little-endian integers, followed by zeros. The samples come next as fixed-width rows of
+ * doubles, each row holding the input values followed by the target values of a sample.
+ *
+ * @note This class is only available on POSIX platforms.
+ */
+
+#ifndef DIWA_MAPPED_H
+#define DIWA_MAPPED_H
+
+#include <diwa.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+
+#define DIWA_MAPPED_HEADER_SIZE 64 /**< Size in bytes of the header of dataset files */
+
+/**
+ *
+ * @class DiwaMappedDataset
+ * @brief Out-of-core dataset read through a memory mapping
+ *        and trained on with a block shuffle.
+ *
+ */
+class DiwaMappedDataset final {
+private:
+    int descriptor;         /**< File descriptor of the dataset file, or -1 */
+    void *mapping;          /**< Start of the memory mapping */
+    size_t mappingSize;     /**< Size of the memory mapping in bytes */
+    const double *rows;     /**< First row of the dataset within the mapping */
+
+    int inputCount;         /**< Number of input values per sample */
+    int targetCount;        /**< Number of target values per sample */
+    int samples;            /**< Number of samples of the dataset */
+
+    int blockSamples;       /**< Number of samples per block */
+    int *blocks;            /**< Order of the blocks, followed by the order of the samples within a block */
+    DiwaRandom randomizer;  /**< Pseudo-random number generator used for shuffling */
+
+    /**
+     * @brief Advises the kernel about the use of a block.
+     *
+     * @param block Index of the block.
+     * @param advice The `madvise()` advice.
+     */
+    void advise(int block, int advice) const;
+
+public:
+    /**
+     * @brief Default constructor for the DiwaMappedDataset class.
+     */
+    DiwaMappedDataset();
+
+    /**
+     * @brief Destructor for the DiwaMappedDataset class.
+     *
+     * Unmaps and closes the dataset file.
+     */
+    ~DiwaMappedDataset();
+
+    /**
+     * @brief Writes the header of a dataset file.
+     *
+     * @param file Output file stream of the dataset file.
+     * @param samples Number of samples that will be written.
+     * @param inputCount Number of input values per sample.
+     * @param targetCount Number of target values per sample.
+     * @return DiwaError indicating the writing status.
+     */
+    static DiwaError writeHeader(std::ofstream& file, int samples, int inputCount, int targetCount);
+
+    /**
+     * @brief Appends samples to a dataset file.
+     *
+     * This method can be called repeatedly after writeHeader(), so that datasets can be
+     * written chunk by chunk.
+     *
+     * @param file Output file stream of the dataset file.
+     * @param inputs Contiguous input values of the samples.
+     * @param targets Contiguous target values of the samples.
+     * @param samples Number of samples to write.
+     * @param inputCount Number of input values per sample.
+     * @param targetCount Number of target values per sample.
+     * @return DiwaError indicating the writing status.
+     */
+    static DiwaError writeSamples(
+        std::ofstream& file,
+        const double *inputs,
+        const double *targets,
+        int samples,
+        int inputCount,
+        int targetCount
+    );
+
+    /**
+     * @brief Maps a dataset file into memory.
+     *
+     * No sample is read by this method; pages are read on demand while training.
+     * Blocks hold 256 KiB of samples unless set otherwise with setBlockSize().
+     *
+     * @param path Path of the dataset file.
+     * @return DiwaError indicating the opening status.
+     */
+    DiwaError open(const char *path);
+
+    /**
+     * @brief Unmaps and closes the dataset file.
+     */
+    void close();
+
+    /**
+     * @brief Sets the number of samples per block.
+     *
+     * Larger blocks give better shuffling, smaller blocks use less memory.
+     *
+     * @param samples Number of samples per block.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError setBlockSize(int samples);
+
+    /**
+     * @brief Seeds the pseudo-random number generator used for shuffling.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Trains the network for one epoch over the dataset.
+     *
+     * The blocks are visited in a shuffled order, and the samples of each block in a
+     * shuffled order too, each of them being trained on once with Diwa::train().
+     *
+     * @param network The neural network to be trained.
+     * @param learningRate Learning rate for the training process.
+     * @return The mean loss of the epoch, or -1 if the dataset does not match the network.
+     */
+    double train(Diwa& network, double learningRate);
+
+    /**
+     * @brief Get the input values of a sample.
+     *
+     * @param sample Index of the sample in the file.
+     * @return Pointer to the `getInputCount()` input values of the sample, within the mapping.
+     */
+    const double *getInputs(int sample) const;
+
+    /**
+     * @brief Get the target values of a sample.
+     *
+     * @param sample Index of the sample in the file.
+     * @return Pointer to the `getTargetCount()` target values of the sample, within the mapping.
+     */
+    const double *getTargets(int sample) const;
+
+    /**
+     * @brief Get the number of samples of the dataset.
+     *
+     * @return The number of samples in the file, or 0 if no file is open.
+     */
+    int getSampleCount() const;
+
+    /**
+     * @brief Get the number of input values per sample.
+     *
+     * @return The number of input values per sample.
+     */
+    int getInputCount() const;
+
+    /**
+     * @brief Get the number of target values per sample.
+     *
+     * @return The number of target values per sample.
+     */
+    int getTargetCount() const;
+
+    /**
+     * @brief Get the number of samples per block.
+     *
+     * @return The number of samples per block.
+     */
+    int getBlockSize() const;
+};
+
+#endif
+
+#endif  // DIWA_MAPPED_H
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_metrics.h>
+#include <stdlib.h>
+
+DiwaMetrics::DiwaMetrics() {
+    this->samples = 0;
+    this->classes = 0;
+    this->confusion = NULL;
+
+    this->meanSquaredError = 0;
+    this->crossEntropy = 0;
+    this->accuracy = 0;
+}
+
+DiwaMetrics::~DiwaMetrics() {
+    free(this->confusion);
+}
+
+DiwaError DiwaMetrics::reset(int classes) {
+    if(classes != this->classes) {
+        int *confusion = (int*) realloc(this->confusion, sizeof(int) * classes * classes);
+        if(confusion == NULL)
+            return MALLOC_FAILED;
+
+        this->confusion = confusion;
+        this->classes = classes;
+    }
+
+    for(int i = 0; i < classes * classes; i++)
+        this->confusion[i] = 0;
+
+    this->samples = 0;
+    this->meanSquaredError = 0;
+    this->crossEntropy = 0;
+    this->accuracy = 0;
+
+    return NO_ERROR;
+}
+
+int DiwaMetrics::getSampleCount() const {
+    return this->samples;
+}
+
+int DiwaMetrics::getClassCount() const {
+    return this->classes;
+}
+
+double DiwaMetrics::getMeanSquaredError() const {
+    return this->meanSquaredError;
+}
+
+double DiwaMetrics::getCrossEntropy() const {
+    return this->crossEntropy;
+}
+
+double DiwaMetrics::getAccuracy() const {
+    return this->accuracy;
+}
+
+int DiwaMetrics::getConfusion(int expected, int predicted) const {
+    if(expected < 0 || expected >= this->classes ||
+        predicted < 0 || predicted >= this->classes)
+        return 0;
+
+    return this->confusion[expected * this->classes + predicted];
+}
+
+const int *DiwaMetrics::getConfusionMatrix() const {
+    return this->samples > 0 ? this->confusion : NULL;
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_metrics.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaMetrics class, which holds
+ *        the results of evaluating the Diwa neural network on a dataset.
+ *
+ * The DiwaMetrics class is filled by Diwa::evaluate() in a single pass over a dataset. It
+ * holds the mean squared error, the cross-entropy, the accuracy and the confusion matrix of
+ * the network on the samples of the dataset.
+ *
+ * Networks with a single output neuron are evaluated as binary classifiers, the output and
+ * the target values being split at 0.5. Networks with several output neurons are evaluated
+ * as multi-class classifiers, the class being the index of the highest value.
+ */
+
+#ifndef DIWA_METRICS_H
+#define DIWA_METRICS_H
+
+#include <diwa.h>
+
+/**
+ *
+ * @class DiwaMetrics
+ * @brief Evaluation metrics of a neural network on a dataset.
+ *
+ * The confusion matrix has one row per expected class and one
+ * column per predicted class, and counts the samples of every
+ * pair of classes.
+ *
+ */
+class DiwaMetrics final {
+    friend class Diwa;
+    friend class DiwaCrossValidation;
+
+private:
+    int samples;            /**< Number of samples evaluated */
+    int classes;            /**< Number of classes of the confusion matrix */
+    int *confusion;         /**< Row-major confusion matrix, indexed by expected then predicted class */
+
+    double meanSquaredError;    /**< Squared error averaged over the samples and output neurons */
+    double crossEntropy;        /**< Cross-entropy averaged over the samples */
+    double accuracy;            /**< Fraction of the samples predicted as their expected class */
+
+    /**
+     * @brief Clears the metrics and allocates the confusion matrix.
+     *
+     * @param classes Number of classes.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError reset(int classes);
+
+public:
+    /**
+     * @brief Default constructor for the DiwaMetrics class.
+     */
+    DiwaMetrics();
+
+    /**
+     * @brief Destructor for the DiwaMetrics class.
+     *
+     * Releases the confusion matrix.
+     */
+    ~DiwaMetrics();
+
+    /**
+     * @brief Get the number of samples evaluated.
+     *
+     * @return The number of samples.
+     */
+    int getSampleCount() const;
+
+    /**
+     * @brief Get the number of classes of the confusion matrix.
+     *
+     * @return 2 for networks with a single output neuron, otherwise the number of output neurons.
+     */
+    int getClassCount() const;
+
+    /**
+     * @brief Get the mean squared error.
+     *
+     * @return The squared error averaged over the samples and the output neurons.
+     */
+    double getMeanSquaredError() const;
+
+    /**
+     * @brief Get the cross-entropy.
+     *
+     * With SOFTMAX_OUTPUT, this is the categorical cross-entropy of the output distribution.
+     * Otherwise, the outputs are taken as independent probabilities and this is the sum of
+     * their binary cross-entropies, which is only meaningful for activation functions with
+     * outputs within (0, 1), such as the sigmoid. Probabilities are clamped to [1e-12, 1 - 1e-12].
+     *
+     * @return The cross-entropy averaged over the samples.
+     */
+    double getCrossEntropy() const;
+
+    /**
+     * @brief Get the accuracy.
+     *
+     * @return The fraction of the samples whose predicted class is their expected class.
+     */
+    double getAccuracy() const;
+
+    /**
+     * @brief Get the number of samples of a class predicted as another class.
+     *
+     * @param expected Index of the expected class.
+     * @param predicted Index of the predicted class.
+     * @return The number of samples, or 0 if either class does not exist.
+     */
+    int getConfusion(int expected, int predicted) const;
+
+    /**
+     * @brief Get the confusion matrix.
+     *
+     * @return Pointer to the row-major matrix of `getClassCount()` squared counts, or NULL
+     *         if nothing was evaluated.
+     */
+    const int *getConfusionMatrix() const;
+};
+
+#endif  // DIWA_METRICS_H
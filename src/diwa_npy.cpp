@@ -0,0 +1,302 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_npy.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Finds the value of a key of the header dictionary, skipping leading spaces
+static size_t findValue(const std::string& header, const char *key) {
+    size_t position = header.find(key);
+    if(position == std::string::npos ||
+        (position = header.find(':', position)) == std::string::npos)
+        return std::string::npos;
+
+    return header.find_first_not_of(' ', position + 1);
+}
+
+DiwaNpy::DiwaNpy() {
+    this->mapping = NULL;
+    this->mappingSize = 0;
+    this->data = NULL;
+
+    this->rows = 0;
+    this->columns = 0;
+    this->singlePrecision = false;
+}
+
+DiwaNpy::~DiwaNpy() {
+    this->close();
+}
+
+DiwaError DiwaNpy::open(const char *path) {
+    this->close();
+
+    const int descriptor = ::open(path, O_RDONLY);
+    if(descriptor < 0)
+        return STREAM_NOT_OPEN;
+
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size < 10) {
+        ::close(descriptor);
+        return MODEL_READ_ERROR;
+    }
+
+    // Mapped privately, so that the values can be modified in place without
+    // changing the file
+    void *mapping = mmap(
+        NULL, status.st_size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, descriptor, 0
+    );
+
+    ::close(descriptor);
+    if(mapping == MAP_FAILED)
+        return MODEL_READ_ERROR;
+
+    this->mapping = mapping;
+    this->mappingSize = status.st_size;
+
+    const uint8_t *bytes = (const uint8_t*) mapping;
+    if(memcmp(bytes, "\x93NUMPY", 6) != 0) {
+        this->close();
+        return INVALID_MAGIC_NUMBER;
+    }
+
+    // Version 1.0 has a 16-bit header length, later versions a 32-bit one
+    size_t offset = bytes[6] == 1 ? 10 : 12, length = bytes[8] | (bytes[9] << 8);
+    if(bytes[6] != 1) {
+        if(this->mappingSize < 12) {
+            this->close();
+            return MODEL_READ_ERROR;
+        }
+
+        length |= ((size_t) bytes[10] << 16) | ((size_t) bytes[11] << 24);
+    }
+
+    if(offset + length > this->mappingSize) {
+        this->close();
+        return MODEL_READ_ERROR;
+    }
+
+    const std::string header((const char*) bytes + offset, length);
+    size_t descr = findValue(header, "'descr'"),
+        order = findValue(header, "'fortran_order'"),
+        shape = findValue(header, "'shape'");
+
+    bool supported = descr != std::string::npos &&
+        order != std::string::npos &&
+        shape != std::string::npos &&
+        header.compare(order, 5, "False") == 0 &&
+        header[shape] == '(';
+
+    if(supported) {
+        if(header.compare(descr, 5, "'<f8'") == 0)
+            this->singlePrecision = false;
+        else if(header.compare(descr, 5, "'<f4'") == 0)
+            this->singlePrecision = true;
+        else supported = false;
+    }
+
+    long dimensions[2] = {0, 1};
+    int dimensionCount = 0;
+
+    for(const char *cursor = header.c_str() + shape + 1;
+        supported && *cursor != ')'; ) {
+        char *end;
+        long dimension = strtol(cursor, &end, 10);
+
+        if(end == cursor || dimension <= 0 || dimension > 0x7FFFFFFF || dimensionCount == 2)
+            supported = false;
+        else {
+            dimensions[dimensionCount++] = dimension;
+
+            cursor = end + strspn(end, ", ");
+        }
+    }
+
+    const size_t valueSize = this->singlePrecision ? sizeof(float) : sizeof(double);
+    if(!supported || dimensionCount == 0 ||
+        (uint64_t) dimensions[0] * dimensions[1] * valueSize >
+            this->mappingSize - offset - length) {
+        this->close();
+        return MODEL_READ_ERROR;
+    }
+
+    this->data = (uint8_t*) mapping + offset + length;
+    this->rows = (int) dimensions[0];
+    this->columns = (int) dimensions[1];
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaNpy::create(const char *path, int rows, int columns, bool singlePrecision) {
+    if(rows <= 0 || columns <= 0)
+        return INVALID_PARAM_VALUES;
+
+    this->close();
+
+    // Version 1.0 header, padded with spaces so that the values start at a
+    // multiple of 64 bytes
+    char header[DIWA_NPY_HEADER_SIZE];
+    memset(header, ' ', sizeof(header));
+    memcpy(header, "\x93NUMPY\x01\x00", 8);
+
+    header[8] = (DIWA_NPY_HEADER_SIZE - 10) & 0xFF;
+    header[9] = (DIWA_NPY_HEADER_SIZE - 10) >> 8;
+
+    const int length = snprintf(
+        header + 10, sizeof(header) - 10,
+        "{'descr': '%s', 'fortran_order': False, 'shape': (%d, %d), }",
+        singlePrecision ? "<f4" : "<f8", rows, columns
+    );
+
+    header[10 + length] = ' ';
+    header[DIWA_NPY_HEADER_SIZE - 1] = '\n';
+
+    const size_t size = DIWA_NPY_HEADER_SIZE + (size_t) rows * columns *
+        (singlePrecision ? sizeof(float) : sizeof(double));
+    const int descriptor = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if(descriptor < 0)
+        return STREAM_NOT_OPEN;
+
+    void *mapping = MAP_FAILED;
+    if(ftruncate(descriptor, size) == 0)
+        mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+    ::close(descriptor);
+    if(mapping == MAP_FAILED)
+        return MODEL_SAVE_ERROR;
+
+    memcpy(mapping, header, DIWA_NPY_HEADER_SIZE);
+
+    this->mapping = mapping;
+    this->mappingSize = size;
+    this->data = (uint8_t*) mapping + DIWA_NPY_HEADER_SIZE;
+
+    this->rows = rows;
+    this->columns = columns;
+    this->singlePrecision = singlePrecision;
+
+    return NO_ERROR;
+}
+
+void DiwaNpy::close() {
+    if(this->mapping != NULL)
+        munmap(this->mapping, this->mappingSize);
+
+    this->mapping = NULL;
+    this->mappingSize = 0;
+    this->data = NULL;
+
+    this->rows = 0;
+    this->columns = 0;
+}
+
+DiwaError DiwaNpy::inference(Diwa& network, DiwaNpy& outputs) const {
+    if(this->mapping == NULL || outputs.mapping == NULL ||
+        this->columns != network.getInputNeurons() ||
+        outputs.rows != this->rows ||
+        outputs.columns != network.getOutputNeurons())
+        return INVALID_PARAM_VALUES;
+
+    double *row = NULL;
+    if(this->singlePrecision &&
+        (row = (double*) malloc(sizeof(double) * this->columns)) == NULL)
+        return MALLOC_FAILED;
+
+    for(int i = 0; i < this->rows; i++) {
+        if(this->singlePrecision)
+            this->getRow(i, row);
+
+        outputs.setRow(i, network.inference(
+            this->singlePrecision ? row :
+                (double*) this->data + (size_t) i * this->columns
+        ));
+    }
+
+    free(row);
+    return NO_ERROR;
+}
+
+void DiwaNpy::getRow(int row, double *values) const {
+    if(!this->singlePrecision) {
+        memcpy(
+            values,
+            (double*) this->data + (size_t) row * this->columns,
+            sizeof(double) * this->columns
+        );
+        return;
+    }
+
+    const float *source = (float*) this->data + (size_t) row * this->columns;
+    for(int i = 0; i < this->columns; i++)
+        values[i] = source[i];
+}
+
+void DiwaNpy::setRow(int row, const double *values) {
+    if(!this->singlePrecision) {
+        memcpy(
+            (double*) this->data + (size_t) row * this->columns,
+            values,
+            sizeof(double) * this->columns
+        );
+        return;
+    }
+
+    float *destination = (float*) this->data + (size_t) row * this->columns;
+    for(int i = 0; i < this->columns; i++)
+        destination[i] = (float) values[i];
+}
+
+double *DiwaNpy::getDoubles() const {
+    return this->singlePrecision ? NULL : (double*) this->data;
+}
+
+float *DiwaNpy::getFloats() const {
+    return this->singlePrecision ? (float*) this->data : NULL;
+}
+
+int DiwaNpy::getRows() const {
+    return this->rows;
+}
+
+int DiwaNpy::getColumns() const {
+    return this->columns;
+}
+
+bool DiwaNpy::isSinglePrecision() const {
+    return this->singlePrecision;
+}
+
+#endif
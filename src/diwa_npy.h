@@ -0,0 +1,180 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_npy.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaNpy class, which maps
+ *        NumPy `.npy` arrays into memory.
+ *
+ * The DiwaNpy class gives access to the values of a `.npy` file without reading or
+ * converting it: the file is mapped into memory and its values are used in place, either
+ * as the storage of a DiwaDataset or as the inputs of a batch inference. The outputs of a
+ * batch inference are written straight into a new `.npy` file mapped the same way, which
+ * NumPy can then load as is.
+ *
+ * Only one- and two-dimensional arrays of little-endian `float64` or `float32` values in
+ * C order are supported. One-dimensional arrays are seen as arrays of one column.
+ *
+ * @note This class is only available on POSIX platforms.
+ */
+
+#ifndef DIWA_NPY_H
+#define DIWA_NPY_H
+
+#include <diwa.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ARDUINO)
+
+#define DIWA_NPY_HEADER_SIZE 128 /**< Size in bytes of the header of the files created by DiwaNpy */
+
+/**
+ *
+ * @class DiwaNpy
+ * @brief Two-dimensional NumPy array mapped from a `.npy` file.
+ *
+ * Opened files are mapped copy-on-write: their values can be
+ * modified in memory, but the changes are never written back to
+ * the file. Created files are mapped shared, so every value set
+ * ends up in the file once it is closed.
+ *
+ */
+class DiwaNpy final {
+private:
+    void *mapping;          /**< Mapping of the whole file, NULL when closed */
+    size_t mappingSize;     /**< Size in bytes of the mapping */
+    void *data;             /**< First value of the array within the mapping */
+
+    int rows;               /**< Number of rows of the array */
+    int columns;            /**< Number of values per row */
+    bool singlePrecision;   /**< Whether the values are float32 rather than float64 */
+
+public:
+    /**
+     * @brief Default constructor for the DiwaNpy class.
+     */
+    DiwaNpy();
+
+    /**
+     * @brief Destructor for the DiwaNpy class.
+     *
+     * Unmaps the array file.
+     */
+    ~DiwaNpy();
+
+    /**
+     * @brief Maps an existing `.npy` file.
+     *
+     * @param path Path of the file.
+     * @return DiwaError indicating the status of the operation, INVALID_MAGIC_NUMBER if
+     *         the file is not a `.npy` file, MODEL_READ_ERROR if the type, order or shape
+     *         of the array is not supported.
+     */
+    DiwaError open(const char *path);
+
+    /**
+     * @brief Creates a `.npy` file holding a zeroed array and maps it.
+     *
+     * @param path Path of the file, which is overwritten if it exists.
+     * @param rows Number of rows of the array.
+     * @param columns Number of values per row.
+     * @param singlePrecision True to store float32 rather than float64 values.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError create(const char *path, int rows, int columns, bool singlePrecision = false);
+
+    /**
+     * @brief Unmaps the array file.
+     */
+    void close();
+
+    /**
+     * @brief Runs the inference of a network over every row of this array.
+     *
+     * Float64 rows are passed to the network in place, while float32 rows are converted
+     * one at a time.
+     *
+     * @param network The neural network, with one input neuron per column of this array.
+     * @param outputs Array receiving the outputs, with as many rows as this array and one
+     *        column per output neuron of the network, e.g. created with create().
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError inference(Diwa& network, DiwaNpy& outputs) const;
+
+    /**
+     * @brief Copies the values of a row, converted to double precision.
+     *
+     * @param row Index of the row.
+     * @param values Array receiving the values of the row.
+     */
+    void getRow(int row, double *values) const;
+
+    /**
+     * @brief Sets the values of a row.
+     *
+     * @param row Index of the row.
+     * @param values Values of the row, rounded to single precision for float32 arrays.
+     */
+    void setRow(int row, const double *values);
+
+    /**
+     * @brief Get the values of a float64 array.
+     *
+     * @return Pointer to the first value of the array, or NULL if the array is closed or
+     *         holds float32 values.
+     */
+    double *getDoubles() const;
+
+    /**
+     * @brief Get the values of a float32 array.
+     *
+     * @return Pointer to the first value of the array, or NULL if the array is closed or
+     *         holds float64 values.
+     */
+    float *getFloats() const;
+
+    /**
+     * @brief Get the number of rows of the array.
+     *
+     * @return The number of rows.
+     */
+    int getRows() const;
+
+    /**
+     * @brief Get the number of values per row of the array.
+     *
+     * @return The number of columns.
+     */
+    int getColumns() const;
+
+    /**
+     * @brief Check whether the array holds float32 values.
+     *
+     * @return True for float32 values, false for float64 values.
+     */
+    bool isSinglePrecision() const;
+};
+
+#endif
+
+#endif  // DIWA_NPY_H
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_online.h>
+
+#ifdef DIWA_THREADS
+
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+DiwaOnline::DiwaOnline(Diwa& network) {
+    this->network = &network;
+    this->sampleSize = 0;
+    this->capacity = 0;
+
+    this->samples = NULL;
+    this->sequences = NULL;
+    this->head = 0;
+    this->tail = 0;
+
+    this->snapshots = NULL;
+    this->latest = 0;
+    for(int i = 0; i < 3; i++)
+        this->readers[i] = 0;
+    this->version = 0;
+
+    this->trained = 0;
+    this->dropped = 0;
+    this->running = false;
+}
+
+DiwaOnline::~DiwaOnline() {
+    this->stop();
+
+    free(this->samples);
+    free(this->snapshots);
+    delete[] this->sequences;
+}
+
+DiwaError DiwaOnline::initialize(int capacity) {
+    if(capacity <= 0 || this->running ||
+        this->network->weightCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    int slots = 1;
+    while(slots < capacity)
+        slots <<= 1;
+
+    const int sampleSize = this->network->inputNeurons +
+        this->network->outputNeurons;
+    const int weightCount = this->network->weightCount;
+
+    free(this->samples);
+    free(this->snapshots);
+    delete[] this->sequences;
+
+    this->samples = (double*) malloc(sizeof(double) * (slots + 1) * sampleSize);
+    this->snapshots = (double*) malloc(sizeof(double) * 3 * weightCount);
+    this->sequences = new std::atomic<size_t>[slots];
+
+    if(this->samples == NULL || this->snapshots == NULL) {
+        free(this->samples);
+        free(this->snapshots);
+        delete[] this->sequences;
+
+        this->samples = NULL;
+        this->snapshots = NULL;
+        this->sequences = NULL;
+        this->capacity = 0;
+
+        return MALLOC_FAILED;
+    }
+
+    this->sampleSize = sampleSize;
+    this->capacity = slots;
+
+    for(int i = 0; i < slots; i++)
+        this->sequences[i].store(i, std::memory_order_relaxed);
+    this->head = 0;
+    this->tail = 0;
+
+    memcpy(this->snapshots, this->network->weights, sizeof(double) * weightCount);
+    this->latest = 0;
+    this->version = 0;
+
+    this->trained = 0;
+    this->dropped = 0;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaOnline::start(double learningRate, int batchSize) {
+    if(batchSize <= 0 || this->capacity == 0 || this->running)
+        return INVALID_PARAM_VALUES;
+
+    this->running = true;
+    this->worker = std::thread(&DiwaOnline::run, this, learningRate, batchSize);
+
+    return NO_ERROR;
+}
+
+void DiwaOnline::stop() {
+    if(!this->worker.joinable())
+        return;
+
+    this->running = false;
+    this->worker.join();
+}
+
+bool DiwaOnline::push(const double *inputs, const double *targets) {
+    if(this->capacity == 0)
+        return false;
+
+    const size_t mask = this->capacity - 1;
+    size_t position = this->head.load(std::memory_order_relaxed);
+
+    for(;;) {
+        const size_t sequence = this->sequences[position & mask]
+            .load(std::memory_order_acquire);
+        const intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+        if(difference == 0) {
+            if(this->head.compare_exchange_weak(
+                position, position + 1,
+                std::memory_order_relaxed
+            ))
+                break;
+        }
+        else if(difference < 0) {
+            this->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else position = this->head.load(std::memory_order_relaxed);
+    }
+
+    const int inputCount = this->network->inputNeurons;
+    double *sample = this->samples + (position & mask) * this->sampleSize;
+
+    memcpy(sample, inputs, sizeof(double) * inputCount);
+    memcpy(sample + inputCount, targets,
+        sizeof(double) * (this->sampleSize - inputCount));
+
+    this->sequences[position & mask].store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool DiwaOnline::pop(double *sample) {
+    std::atomic<size_t>& sequence = this->sequences[this->tail & (this->capacity - 1)];
+    if(sequence.load(std::memory_order_acquire) != this->tail + 1)
+        return false;
+
+    memcpy(
+        sample,
+        this->samples + (this->tail & (this->capacity - 1)) * this->sampleSize,
+        sizeof(double) * this->sampleSize
+    );
+
+    sequence.store(this->tail + this->capacity, std::memory_order_release);
+    this->tail++;
+
+    return true;
+}
+
+bool DiwaOnline::publish() {
+    const int current = this->latest.load();
+    const int weightCount = this->network->weightCount;
+
+    for(int i = 0; i < 3; i++)
+        if(i != current && this->readers[i].load() == 0) {
+            memcpy(
+                this->snapshots + i * weightCount,
+                this->network->weights,
+                sizeof(double) * weightCount
+            );
+
+            this->latest.store(i);
+            this->version.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+    return false;
+}
+
+void DiwaOnline::run(double learningRate, int batchSize) {
+    double *sample = this->samples + this->capacity * this->sampleSize;
+    double *targets = sample + this->network->inputNeurons;
+    bool pending = false;
+
+    while(this->running.load(std::memory_order_acquire)) {
+        int count = 0;
+        for(; count < batchSize && this->pop(sample); count++)
+            this->network->train(learningRate, sample, targets);
+
+        if(count > 0) {
+            this->trained.fetch_add(count, std::memory_order_relaxed);
+            pending = true;
+        }
+
+        if(pending)
+            pending = !this->publish();
+
+        if(count < batchSize)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    while(pending && !this->publish())
+        std::this_thread::yield();
+}
+
+double *DiwaOnline::inference(const double *inputs, double *outputs) {
+    int index;
+
+    for(;;) {
+        index = this->latest.load();
+        this->readers[index].fetch_add(1);
+
+        if(this->latest.load() == index)
+            break;
+        this->readers[index].fetch_sub(1);
+    }
+
+    double *result = this->network->forward<double>(
+        this->snapshots + index * this->network->weightCount,
+        outputs, inputs,
+        NULL, false
+    );
+
+    this->readers[index].fetch_sub(1);
+    return result;
+}
+
+uint64_t DiwaOnline::getVersion() const {
+    return this->version.load(std::memory_order_relaxed);
+}
+
+uint64_t DiwaOnline::getTrained() const {
+    return this->trained.load(std::memory_order_relaxed);
+}
+
+uint64_t DiwaOnline::getDropped() const {
+    return this->dropped.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_online.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaOnline class, which keeps
+ *        training a Diwa neural network in the background while it serves inferences.
+ *
+ * The DiwaOnline class lets any number of threads run inferences and push labeled samples
+ * (e.g. feedback on earlier inferences) into a bounded replay buffer. A background thread
+ * drains the replay buffer in mini-batches, trains the network on them with Diwa::train(),
+ * and publishes the updated weights after every mini-batch.
+ *
+ * @note Neither inferences nor pushes ever wait for training. The replay buffer is a
+ *       lock-free multi-producer single-consumer ring, and samples pushed while it is full
+ *       are dropped. The weights are published through three snapshot buffers, so that an
+ *       inference always reads a complete snapshot while the next one is being written.
+ *       This class is only available on desktop platforms.
+ */
+
+#ifndef DIWA_ONLINE_H
+#define DIWA_ONLINE_H
+
+#include <diwa.h>
+
+#ifdef DIWA_THREADS
+
+#include <atomic>
+#include <thread>
+
+/**
+ *
+ * @class DiwaOnline
+ * @brief Online learner serving inferences while training
+ *        on a replay buffer in a background thread.
+ *
+ * The DiwaOnline class wraps a Diwa neural network. Once
+ * started, the network belongs to the background thread and
+ * must not be used directly until stop() is called; inferences
+ * go through DiwaOnline::inference(), which reads the most
+ * recently published weights.
+ *
+ */
+class DiwaOnline final {
+private:
+    Diwa *network;          /**< Neural network being trained */
+    int sampleSize;         /**< Number of values per sample, inputs followed by targets */
+    int capacity;           /**< Number of slots of the replay buffer, a power of two */
+
+    double *samples;        /**< Values of the samples held by the replay buffer, followed by one sample popped by the consumer */
+    std::atomic<size_t> *sequences; /**< Sequence number of every slot of the replay buffer */
+    std::atomic<size_t> head;       /**< Position of the next slot to be claimed by a producer */
+    size_t tail;                    /**< Position of the next slot to be consumed */
+
+    double *snapshots;              /**< Three snapshots of the weights */
+    std::atomic<int> latest;        /**< Index of the most recently published snapshot */
+    std::atomic<int> readers[3];    /**< Number of inferences reading each snapshot */
+    std::atomic<uint64_t> version;  /**< Number of snapshots published */
+
+    std::atomic<uint64_t> trained;  /**< Number of samples trained on */
+    std::atomic<uint64_t> dropped;  /**< Number of samples dropped because the replay buffer was full */
+    std::atomic<bool> running;      /**< Whether the background thread should keep running */
+    std::thread worker;             /**< Background training thread */
+
+    /**
+     * @brief Pops the oldest sample of the replay buffer.
+     *
+     * @param sample Array of `sampleSize` values receiving the inputs and targets of the sample.
+     * @return True if a sample was popped, false if the replay buffer is empty.
+     */
+    bool pop(double *sample);
+
+    /**
+     * @brief Publishes the current weights of the network.
+     *
+     * The weights are copied into a snapshot buffer that is neither the latest snapshot nor
+     * being read, which then becomes the latest snapshot.
+     *
+     * @return True if the weights were published, false if every other buffer is being read.
+     */
+    bool publish();
+
+    /**
+     * @brief Body of the background training thread.
+     *
+     * @param learningRate Learning rate for the training process.
+     * @param batchSize Maximum number of samples trained on between two publications.
+     */
+    void run(double learningRate, int batchSize);
+
+public:
+    /**
+     * @brief Constructs an online learner for the given neural network.
+     *
+     * @param network The initialized neural network to be trained. It must outlive the learner.
+     */
+    DiwaOnline(Diwa& network);
+
+    /**
+     * @brief Destructor for the DiwaOnline class.
+     *
+     * Stops the background thread and releases the replay buffer and the snapshots.
+     */
+    ~DiwaOnline();
+
+    /**
+     * @brief Allocates the replay buffer and publishes the initial weights.
+     *
+     * @param capacity Number of samples the replay buffer can hold, rounded up to a power of two.
+     * @return DiwaError indicating the initialization status.
+     */
+    DiwaError initialize(int capacity);
+
+    /**
+     * @brief Starts the background training thread.
+     *
+     * The thread trains the network on every sample of the replay buffer, and publishes
+     * the weights after at most `batchSize` samples. It sleeps while the replay buffer is
+     * empty.
+     *
+     * @param learningRate Learning rate for the training process.
+     * @param batchSize Maximum number of samples trained on between two publications.
+     * @return DiwaError indicating the starting status.
+     */
+    DiwaError start(double learningRate, int batchSize);
+
+    /**
+     * @brief Stops the background training thread.
+     *
+     * Samples left in the replay buffer are kept for the next start(), and the
+     * network can be used directly again.
+     */
+    void stop();
+
+    /**
+     * @brief Pushes a labeled sample into the replay buffer.
+     *
+     * This method can be called from any number of threads concurrently. It never waits:
+     * when the replay buffer is full, the sample is dropped.
+     *
+     * @param inputs Input values of the sample.
+     * @param targets Target values of the sample.
+     * @return True if the sample was queued, false if it was dropped.
+     */
+    bool push(const double *inputs, const double *targets);
+
+    /**
+     * @brief Performs inference with the most recently published weights.
+     *
+     * This method can be called from any number of threads concurrently, each one giving
+     * its own outputs array. It never waits for the background thread.
+     *
+     * @param inputs Input values of the sample.
+     * @param outputs Array of at least `getNeuronCount()` elements receiving the neuron outputs.
+     * @return Pointer to the output values of the output layer within the outputs array.
+     */
+    double *inference(const double *inputs, double *outputs);
+
+    /**
+     * @brief Get the number of snapshots published.
+     *
+     * @return The number of weight snapshots published by the background thread.
+     */
+    uint64_t getVersion() const;
+
+    /**
+     * @brief Get the number of samples trained on.
+     *
+     * @return The number of samples popped from the replay buffer and trained on.
+     */
+    uint64_t getTrained() const;
+
+    /**
+     * @brief Get the number of dropped samples.
+     *
+     * @return The number of samples pushed while the replay buffer was full.
+     */
+    uint64_t getDropped() const;
+};
+
+#endif
+
+#endif  // DIWA_ONLINE_H
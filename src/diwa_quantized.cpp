@@ -0,0 +1,369 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_quantized.h>
+#include <diwa_conv.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)) && \
+    !defined(ARDUINO)
+
+static inline void writeToStream(std::ofstream& stream, const uint8_t* data, size_t size) {
+    stream.write(reinterpret_cast<const char*>(data), size);
+    delete[] data;
+}
+
+#elif defined(ARDUINO)
+
+static inline void writeToFile(File& file, const uint8_t* data, size_t size) {
+    file.write(data, size);
+    delete[] data;
+}
+
+#endif
+
+DiwaQuantized::DiwaQuantized() {
+    this->inputNeurons = 0;
+    this->hiddenNeurons = 0;
+    this->hiddenLayers = 0;
+    this->outputNeurons = 0;
+
+    this->weightCount = 0;
+    this->neuronCount = 0;
+
+    this->scales = NULL;
+    this->outputs = NULL;
+    this->weights = NULL;
+
+    this->activation = DiwaActivationFunc::sigmoid;
+    this->outputMode = ACTIVATION_OUTPUT;
+}
+
+DiwaQuantized::~DiwaQuantized() {
+    free(this->scales);
+}
+
+DiwaError DiwaQuantized::allocate(
+    int inputNeurons,
+    int hiddenLayers,
+    int hiddenNeurons,
+    int outputNeurons
+) {
+    if(inputNeurons <= 0 || hiddenLayers < 0 || outputNeurons <= 0 ||
+        (hiddenLayers > 0 && hiddenNeurons <= 0))
+        return INVALID_PARAM_VALUES;
+
+    const int weightCount = hiddenLayers ?
+        (inputNeurons + 1) * hiddenNeurons +
+            (hiddenLayers - 1) * (hiddenNeurons + 1) * hiddenNeurons +
+            (hiddenNeurons + 1) * outputNeurons :
+        (inputNeurons + 1) * outputNeurons;
+    const int neuronCount = inputNeurons + hiddenNeurons * hiddenLayers + outputNeurons;
+
+    double *buffer = (double*) realloc(
+        this->scales,
+        sizeof(double) * (hiddenLayers + 1 + neuronCount) + weightCount
+    );
+    if(buffer == NULL)
+        return MALLOC_FAILED;
+
+    this->inputNeurons = inputNeurons;
+    this->hiddenLayers = hiddenLayers;
+    this->hiddenNeurons = hiddenNeurons;
+    this->outputNeurons = outputNeurons;
+
+    this->weightCount = weightCount;
+    this->neuronCount = neuronCount;
+
+    this->scales = buffer;
+    this->outputs = buffer + hiddenLayers + 1;
+    this->weights = (int8_t*) (this->outputs + neuronCount);
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaQuantized::quantize(const Diwa& network) {
+    DiwaError error;
+    if((error = this->allocate(
+        network.inputNeurons,
+        network.hiddenLayers,
+        network.hiddenNeurons,
+        network.outputNeurons
+    )) != NO_ERROR)
+        return error;
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        int offset, count;
+        const double scale = network.quantizationScale(h, &offset, &count);
+
+        this->scales[h] = scale;
+        for(int i = offset; i < offset + count; i++)
+            this->weights[i] = scale > 0 ?
+                (int8_t) round(network.weights[i] / scale) : 0;
+    }
+
+    this->activation = network.activation;
+    this->outputMode = network.outputMode;
+
+    return NO_ERROR;
+}
+
+double* DiwaQuantized::inference(const double *inputNeurons) {
+    if(this->scales == NULL)
+        return NULL;
+
+    memcpy(this->outputs, inputNeurons, sizeof(double) * this->inputNeurons);
+
+    const int8_t *weights = this->weights;
+    const double *inputs = this->outputs;
+    double *outputs = this->outputs + this->inputNeurons;
+    int inputCount = this->inputNeurons;
+
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        const bool last = h == this->hiddenLayers;
+        const int outputCount = last ? this->outputNeurons : this->hiddenNeurons;
+
+        for(int j = 0; j < outputCount; ++j) {
+            double sum = -*weights++;
+
+            for(int k = 0; k < inputCount; ++k)
+                sum += *weights++ * inputs[k];
+
+            sum *= this->scales[h];
+            outputs[j] = last && this->outputMode == SOFTMAX_OUTPUT ?
+                sum : this->activation(sum);
+        }
+
+        inputs = outputs;
+        outputs += outputCount;
+        inputCount = outputCount;
+    }
+
+    outputs = this->outputs + this->neuronCount - this->outputNeurons;
+    if(this->outputMode == SOFTMAX_OUTPUT) {
+        double max = outputs[0], sum = 0;
+
+        for(int j = 1; j < this->outputNeurons; ++j)
+            max = outputs[j] > max ? outputs[j] : max;
+
+        for(int j = 0; j < this->outputNeurons; ++j) {
+            outputs[j] = exp(outputs[j] - max);
+            sum += outputs[j];
+        }
+
+        for(int j = 0; j < this->outputNeurons; ++j)
+            outputs[j] /= sum;
+    }
+
+    return outputs;
+}
+
+int DiwaQuantized::classify(const double *inputNeurons) {
+    const double *outputs = this->inference(inputNeurons);
+    if(outputs == NULL)
+        return -1;
+
+    int index = 0;
+    for(int j = 1; j < this->outputNeurons; ++j)
+        if(outputs[j] > outputs[index])
+            index = j;
+
+    return index;
+}
+
+double DiwaQuantized::calculateAccuracy(const double *inputs, const double *targets, int samples) {
+    if(this->scales == NULL || samples <= 0)
+        return 0;
+
+    int correct = 0;
+    for(int i = 0; i < samples; i++) {
+        const double *target = targets + i * this->outputNeurons;
+
+        if(this->outputMode == SOFTMAX_OUTPUT) {
+            int expected = 0;
+            for(int j = 1; j < this->outputNeurons; ++j)
+                if(target[j] > target[expected])
+                    expected = j;
+
+            if(this->classify(inputs + i * this->inputNeurons) == expected)
+                correct++;
+            continue;
+        }
+
+        const double *outputs = this->inference(inputs + i * this->inputNeurons);
+        bool matches = true;
+
+        for(int j = 0; j < this->outputNeurons; ++j)
+            if((outputs[j] >= 0.5) != (target[j] >= 0.5))
+                matches = false;
+
+        if(matches)
+            correct++;
+    }
+
+    return (double) correct / samples;
+}
+
+void DiwaQuantized::setActivationFunction(diwa_activation activation) {
+    this->activation = activation;
+}
+
+#ifdef ARDUINO
+
+DiwaError DiwaQuantized::loadFromFile(File annFile) {
+    uint8_t magic[4];
+    annFile.read(magic, 4);
+
+    if(memcmp(magic, "diwq", 4) != 0)
+        return INVALID_MAGIC_NUMBER;
+
+    uint8_t temp_int[4];
+    int header[5];
+
+    for(int i = 0; i < 5; i++) {
+        if(annFile.read(temp_int, 4) != 4)
+            return MODEL_READ_ERROR;
+
+        header[i] = DiwaConv::u8aToInt(temp_int);
+    }
+
+    if(header[4] != ACTIVATION_OUTPUT && header[4] != SOFTMAX_OUTPUT)
+        return MODEL_READ_ERROR;
+
+    DiwaError error;
+    if((error = this->allocate(header[0], header[2], header[1], header[3])) != NO_ERROR)
+        return error;
+    this->outputMode = (DiwaOutputMode) header[4];
+
+    uint8_t temp_db[8];
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        annFile.read(temp_db, 8);
+        this->scales[h] = DiwaConv::u8aToDouble(temp_db);
+    }
+
+    if(annFile.read((uint8_t*) this->weights, this->weightCount) != (size_t) this->weightCount)
+        return MODEL_READ_ERROR;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaQuantized::saveToFile(File annFile) {
+    if(this->scales == NULL)
+        return MODEL_SAVE_ERROR;
+
+    writeToFile(annFile, new uint8_t[4] {'d', 'i', 'w', 'q'}, 4);
+
+    writeToFile(annFile, DiwaConv::intToU8a(this->inputNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->hiddenNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->hiddenLayers), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->outputNeurons), 4);
+    writeToFile(annFile, DiwaConv::intToU8a(this->outputMode), 4);
+
+    for(int h = 0; h <= this->hiddenLayers; ++h)
+        writeToFile(annFile, DiwaConv::doubleToU8a(this->scales[h]), 8);
+
+    annFile.write((const uint8_t*) this->weights, this->weightCount);
+    annFile.flush();
+
+    return NO_ERROR;
+}
+
+#elif defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)
+
+DiwaError DiwaQuantized::loadFromFile(std::ifstream& annFile) {
+    if(!annFile.is_open())
+        return STREAM_NOT_OPEN;
+
+    char magic[4];
+    annFile.read(magic, 4);
+
+    if(!annFile || memcmp(magic, "diwq", 4) != 0)
+        return INVALID_MAGIC_NUMBER;
+
+    uint8_t temp_int[4];
+    int header[5];
+
+    for(int i = 0; i < 5; i++) {
+        if(!annFile.read(reinterpret_cast<char*>(temp_int), 4))
+            return MODEL_READ_ERROR;
+
+        header[i] = DiwaConv::u8aToInt(temp_int);
+    }
+
+    if(header[4] != ACTIVATION_OUTPUT && header[4] != SOFTMAX_OUTPUT)
+        return MODEL_READ_ERROR;
+
+    DiwaError error;
+    if((error = this->allocate(header[0], header[2], header[1], header[3])) != NO_ERROR)
+        return error;
+    this->outputMode = (DiwaOutputMode) header[4];
+
+    uint8_t temp_db[8];
+    for(int h = 0; h <= this->hiddenLayers; ++h) {
+        annFile.read(reinterpret_cast<char*>(temp_db), 8);
+        this->scales[h] = DiwaConv::u8aToDouble(temp_db);
+    }
+
+    if(!annFile.read(reinterpret_cast<char*>(this->weights), this->weightCount))
+        return MODEL_READ_ERROR;
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaQuantized::saveToFile(std::ofstream& annFile) {
+    if(!annFile.is_open())
+        return STREAM_NOT_OPEN;
+    else if(this->scales == NULL)
+        return MODEL_SAVE_ERROR;
+
+    writeToStream(annFile, new uint8_t[4] {'d', 'i', 'w', 'q'}, 4);
+
+    writeToStream(annFile, DiwaConv::intToU8a(this->inputNeurons), 4);
+    writeToStream(annFile, DiwaConv::intToU8a(this->hiddenNeurons), 4);
+    writeToStream(annFile, DiwaConv::intToU8a(this->hiddenLayers), 4);
+    writeToStream(annFile, DiwaConv::intToU8a(this->outputNeurons), 4);
+    writeToStream(annFile, DiwaConv::intToU8a(this->outputMode), 4);
+
+    for(int h = 0; h <= this->hiddenLayers; ++h)
+        writeToStream(annFile, DiwaConv::doubleToU8a(this->scales[h]), 8);
+
+    annFile.write(reinterpret_cast<const char*>(this->weights), this->weightCount);
+    return annFile ? NO_ERROR : MODEL_SAVE_ERROR;
+}
+
+#endif
+
+int DiwaQuantized::getWeightCount() const {
+    return this->weightCount;
+}
+
+int DiwaQuantized::getModelSize() const {
+    return 4 + 5 * 4 + (this->hiddenLayers + 1) * 8 + this->weightCount;
+}
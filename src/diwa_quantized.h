@@ -0,0 +1,203 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_quantized.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaQuantized class, a compact
+ *        int8 inference-only version of the Diwa neural network.
+ *
+ * The DiwaQuantized class stores every weight of a trained Diwa neural network as a
+ * signed 8-bit level of a symmetric per-layer quantization, an eighth of the size of
+ * the double precision weights. Quantized models are saved into and loaded from their
+ * own model file format, starting with the "diwq" magic number, so they can be deployed
+ * to boards with little storage and memory.
+ *
+ * @note Networks meant to be quantized are best trained with Diwa::setQuantizationAware(),
+ *       which makes them learn weights that keep their accuracy once rounded, instead of
+ *       quantizing an ordinarily trained network after the fact.
+ */
+
+#ifndef DIWA_QUANTIZED_H
+#define DIWA_QUANTIZED_H
+
+#include <diwa.h>
+
+/**
+ *
+ * @class DiwaQuantized
+ * @brief Inference-only neural network with int8 weights.
+ *
+ * The DiwaQuantized class runs the same forward pass as the
+ * Diwa class, dequantizing the sum of every neuron with the
+ * scale of its layer. The outputs are kept in double precision.
+ *
+ */
+class DiwaQuantized final {
+private:
+    int inputNeurons;       /**< Number of input neurons */
+    int hiddenNeurons;      /**< Number of neurons in each hidden layer */
+    int hiddenLayers;       /**< Number of hidden layers */
+    int outputNeurons;      /**< Number of output neurons */
+
+    int weightCount;        /**< Total number of weights */
+    int neuronCount;        /**< Total number of neurons */
+
+    double *scales;         /**< Quantization scale of every layer, followed by the outputs and the weights */
+    double *outputs;        /**< Outputs of every neuron */
+    int8_t *weights;        /**< Quantized weights, laid out like the weights of the Diwa class */
+
+    diwa_activation activation; /**< Activation function of the hidden and output layers */
+    DiwaOutputMode outputMode;  /**< Output layer mode */
+
+    /**
+     * @brief Allocates the scales, outputs and weights for the given topology.
+     *
+     * @return DiwaError indicating the allocation status.
+     */
+    DiwaError allocate(int inputNeurons, int hiddenLayers, int hiddenNeurons, int outputNeurons);
+
+public:
+    /**
+     * @brief Default constructor for the DiwaQuantized class.
+     *
+     * The network is empty until a Diwa network is quantized or a quantized model is loaded.
+     */
+    DiwaQuantized();
+
+    /**
+     * @brief Destructor for the DiwaQuantized class.
+     *
+     * Releases the scales, outputs and weights.
+     */
+    ~DiwaQuantized();
+
+    /**
+     * @brief Quantizes the weights of a Diwa neural network.
+     *
+     * The activation function and the output mode of the network are copied along with
+     * its topology. The scales are the ones used by quantization-aware training, so a
+     * network trained with Diwa::setQuantizationAware() is quantized without any change
+     * to the weights it was trained with.
+     *
+     * @param network The neural network to be quantized.
+     * @return DiwaError indicating the quantization status.
+     */
+    DiwaError quantize(const Diwa& network);
+
+    /**
+     * @brief Performs inference on the quantized network.
+     *
+     * @param inputNeurons Array of input values.
+     * @return Pointer to the output values, owned by the network.
+     */
+    double* inference(const double *inputNeurons);
+
+    /**
+     * @brief Classifies the given inputs.
+     *
+     * @param inputNeurons Array of input values.
+     * @return Index of the output neuron with the highest output.
+     */
+    int classify(const double *inputNeurons);
+
+    /**
+     * @brief Calculates the accuracy of the quantized network over a dataset.
+     *
+     * With SOFTMAX_OUTPUT, a sample is correct when its class is the one of the highest
+     * target. Otherwise, every output must be on the same side of 0.5 as its target.
+     *
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @return The fraction of correctly inferred samples.
+     */
+    double calculateAccuracy(const double *inputs, const double *targets, int samples);
+
+    /**
+     * @brief Sets the activation function used by the quantized network.
+     *
+     * Model files do not store the activation function, so it must be set after loading
+     * a model trained with another activation than DiwaActivationFunc::sigmoid.
+     *
+     * @param activation The activation function.
+     */
+    void setActivationFunction(diwa_activation activation);
+
+    #ifdef ARDUINO
+
+    /**
+     * @brief Load quantized model from file in Arduino environment.
+     *
+     * @param annFile File object representing the quantized model file.
+     * @return DiwaError indicating the loading status.
+     */
+    DiwaError loadFromFile(File annFile);
+
+    /**
+     * @brief Save quantized model to file in Arduino environment.
+     *
+     * @param annFile File object representing the destination file for the model.
+     * @return DiwaError indicating the saving status.
+     */
+    DiwaError saveToFile(File annFile);
+
+    #elif defined(__GNUC__) || \
+        defined(__GNUG__) || \
+        defined(__clang__) || \
+        defined(_MSC_VER)
+
+    /**
+     * @brief Load quantized model from file in non-Arduino environment.
+     *
+     * @param annFile Input file stream representing the quantized model file.
+     * @return DiwaError indicating the loading status.
+     */
+    DiwaError loadFromFile(std::ifstream& annFile);
+
+    /**
+     * @brief Save quantized model to file in non-Arduino environment.
+     *
+     * @param annFile Output file stream representing the destination file for the model.
+     * @return DiwaError indicating the saving status.
+     */
+    DiwaError saveToFile(std::ofstream& annFile);
+
+    #endif
+
+    /**
+     * @brief Get the total number of weights in the network.
+     *
+     * @return Total number of weights.
+     */
+    int getWeightCount() const;
+
+    /**
+     * @brief Get the size of the quantized model file.
+     *
+     * @return The number of bytes written by saveToFile().
+     */
+    int getModelSize() const;
+};
+
+#endif  // DIWA_QUANTIZED_H
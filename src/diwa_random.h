@@ -0,0 +1,169 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_random.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Seedable pseudo-random number generator for the Diwa neural network library.
+ *
+ * This file provides the DiwaRandom class, an implementation of the xoshiro256**
+ * pseudo-random number generator. Unlike the global `rand()` and `random()` functions,
+ * each DiwaRandom instance keeps its own state, so several neural networks can be
+ * initialized and trained in parallel without sharing (or racing on) a generator, and
+ * the same seed always reproduces the same sequence on every platform.
+ */
+
+#ifndef DIWA_RANDOM_H
+#define DIWA_RANDOM_H
+
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * @brief Per-instance xoshiro256** pseudo-random number generator.
+ *
+ * The DiwaRandom class generates 64-bit pseudo-random numbers using the xoshiro256**
+ * algorithm, and derives uniformly and normally distributed floating-point numbers from
+ * them. The 256-bit state is expanded from a 64-bit seed using splitmix64.
+ */
+class DiwaRandom final {
+private:
+    uint64_t state[4]; /**< The 256-bit state of the generator. */
+
+    /**
+     * @brief Rotates a 64-bit value to the left.
+     *
+     * @param value The value to be rotated.
+     * @param count The number of bits to rotate by.
+     * @return The rotated value.
+     */
+    static inline uint64_t rotate(uint64_t value, int count) {
+        return (value << count) | (value >> (64 - count));
+    }
+
+public:
+    /**
+     * @brief Constructs a generator seeded with zero.
+     */
+    DiwaRandom() {
+        this->seed(0);
+    }
+
+    /**
+     * @brief Seeds the generator.
+     *
+     * The state of the generator is expanded from the given seed using splitmix64,
+     * which guarantees a non-zero state for every seed.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    inline void seed(uint64_t seed) {
+        for(uint8_t i = 0; i < 4; ++i) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            this->state[i] = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @brief Generates the next 64-bit pseudo-random number.
+     *
+     * @return A uniformly distributed 64-bit unsigned integer.
+     */
+    inline uint64_t next() {
+        const uint64_t result = DiwaRandom::rotate(this->state[1] * 5, 7) * 9;
+        const uint64_t t = this->state[1] << 17;
+
+        this->state[2] ^= this->state[0];
+        this->state[3] ^= this->state[1];
+        this->state[1] ^= this->state[2];
+        this->state[0] ^= this->state[3];
+
+        this->state[2] ^= t;
+        this->state[3] = DiwaRandom::rotate(this->state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Generates a uniformly distributed number within [0, 1).
+     *
+     * @return A double value greater than or equal to 0 and less than 1.
+     */
+    inline double nextDouble() {
+        return (this->next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Generates a uniformly distributed number within [min, max).
+     *
+     * @param min The inclusive lower bound.
+     * @param max The exclusive upper bound.
+     * @return A double value within the given bounds.
+     */
+    inline double nextUniform(double min, double max) {
+        return min + (max - min) * this->nextDouble();
+    }
+
+    /**
+     * @brief Generates a normally distributed number.
+     *
+     * The number is generated with the Box-Muller transform.
+     *
+     * @param mean The mean of the distribution.
+     * @param deviation The standard deviation of the distribution.
+     * @return A double value drawn from the given normal distribution.
+     */
+    inline double nextGaussian(double mean, double deviation) {
+        const double u = 1.0 - this->nextDouble();
+        const double v = this->nextDouble();
+
+        return mean + deviation *
+            sqrt(-2.0 * log(u)) *
+            cos(6.283185307179586 * v);
+    }
+
+    /**
+     * @brief Copies the state of the generator.
+     *
+     * @param state Array of four values receiving the state of the generator.
+     */
+    inline void getState(uint64_t state[4]) const {
+        for(uint8_t i = 0; i < 4; ++i)
+            state[i] = this->state[i];
+    }
+
+    /**
+     * @brief Restores a state previously retrieved with getState().
+     *
+     * @param state Array of four values holding the state of the generator.
+     */
+    inline void setState(const uint64_t state[4]) {
+        for(uint8_t i = 0; i < 4; ++i)
+            this->state[i] = state[i];
+    }
+};
+
+#endif  // DIWA_RANDOM_H
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_sampler.h>
+#include <stdlib.h>
+
+#define DIWA_SAMPLER_EPSILON 1e-6 /**< Added to every loss so that every sample can still be drawn */
+
+DiwaSampler::DiwaSampler() {
+    this->samples = 0;
+    this->capacity = 0;
+
+    this->sums = NULL;
+    this->minimums = NULL;
+
+    this->alpha = 0.6;
+    this->beta = 0.4;
+}
+
+DiwaSampler::~DiwaSampler() {
+    free(this->sums);
+}
+
+DiwaError DiwaSampler::initialize(int samples) {
+    if(samples <= 0)
+        return INVALID_PARAM_VALUES;
+
+    int capacity = 1;
+    while(capacity < samples)
+        capacity <<= 1;
+
+    double *trees = (double*) realloc(this->sums, sizeof(double) * 4 * capacity);
+    if(trees == NULL)
+        return MALLOC_FAILED;
+
+    this->samples = samples;
+    this->capacity = capacity;
+    this->sums = trees;
+    this->minimums = trees + 2 * capacity;
+
+    for(int i = 0; i < capacity; i++) {
+        this->sums[capacity + i] = i < samples ? 1.0 : 0.0;
+        this->minimums[capacity + i] = i < samples ? 1.0 : HUGE_VAL;
+    }
+
+    for(int i = capacity - 1; i > 0; i--) {
+        this->sums[i] = this->sums[2 * i] + this->sums[2 * i + 1];
+        this->minimums[i] = fmin(this->minimums[2 * i], this->minimums[2 * i + 1]);
+    }
+
+    return NO_ERROR;
+}
+
+void DiwaSampler::setPriorityExponent(double alpha) {
+    this->alpha = alpha;
+}
+
+void DiwaSampler::setImportanceExponent(double beta) {
+    this->beta = beta;
+}
+
+void DiwaSampler::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+}
+
+void DiwaSampler::update(int index, double loss) {
+    if(index < 0 || index >= this->samples)
+        return;
+
+    const double priority = pow(fabs(loss) + DIWA_SAMPLER_EPSILON, this->alpha);
+
+    int node = this->capacity + index;
+    this->sums[node] = priority;
+    this->minimums[node] = priority;
+
+    for(node >>= 1; node > 0; node >>= 1) {
+        this->sums[node] = this->sums[2 * node] + this->sums[2 * node + 1];
+        this->minimums[node] = fmin(this->minimums[2 * node], this->minimums[2 * node + 1]);
+    }
+}
+
+int DiwaSampler::sample(double *weight) {
+    double target = this->randomizer.nextDouble() * this->sums[1];
+
+    int node = 1;
+    while(node < this->capacity) {
+        node <<= 1;
+
+        if(target >= this->sums[node] && this->sums[node + 1] > 0) {
+            target -= this->sums[node];
+            node++;
+        }
+    }
+
+    if(weight != NULL)
+        *weight = pow(this->minimums[1] / this->sums[node], this->beta);
+
+    return node - this->capacity;
+}
+
+double DiwaSampler::train(
+    Diwa& network,
+    double learningRate,
+    double *inputs,
+    double *targets,
+    int batchSize
+) {
+    if(this->samples <= 0 || batchSize <= 0)
+        return 0;
+
+    const int inputCount = network.getInputNeurons();
+    const int outputCount = network.getOutputNeurons();
+
+    double loss = 0;
+    for(int b = 0; b < batchSize; b++) {
+        double weight;
+        const int index = this->sample(&weight);
+
+        const double sampleLoss = network.train(
+            learningRate * weight,
+            inputs + index * inputCount,
+            targets + index * outputCount
+        );
+
+        this->update(index, sampleLoss);
+        loss += sampleLoss;
+    }
+
+    return loss / batchSize;
+}
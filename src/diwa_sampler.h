@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_sampler.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaSampler class, a
+ *        loss-prioritized sampler for training the Diwa neural network.
+ *
+ * The DiwaSampler class draws training samples with a probability proportional to
+ * their most recent loss (raised to a priority exponent), so that training focuses on
+ * the samples the network still gets wrong instead of repeating those it already fits.
+ * The priorities are kept in a sum-tree and a min-tree, so drawing a sample, updating
+ * its loss and computing its importance weight all take O(log n) time.
+ *
+ * @note Since prioritized sampling biases the gradient, every drawn sample comes with an
+ *       importance weight `(n * P(i))^-beta`, normalized by the largest weight, which scales
+ *       the learning rate of that sample to correct the bias.
+ */
+
+#ifndef DIWA_SAMPLER_H
+#define DIWA_SAMPLER_H
+
+#include <diwa.h>
+
+/**
+ *
+ * @class DiwaSampler
+ * @brief Loss-prioritized sampler backed by a sum-tree.
+ *
+ * The DiwaSampler class holds one priority per sample of a
+ * dataset, derived from the loss the sample had the last time
+ * the network was trained on it. Every sample starts with the
+ * priority of a loss of 1.
+ *
+ */
+class DiwaSampler final {
+private:
+    int samples;        /**< Number of samples in the dataset */
+    int capacity;       /**< Number of leaves of the trees, a power of two */
+
+    double *sums;       /**< Sum-tree of the priorities */
+    double *minimums;   /**< Min-tree of the priorities */
+
+    double alpha;       /**< Exponent applied to the losses to obtain priorities */
+    double beta;        /**< Exponent of the importance weight correction */
+
+    DiwaRandom randomizer; /**< Pseudo-random number generator of this sampler */
+
+public:
+    /**
+     * @brief Default constructor for the DiwaSampler class.
+     *
+     * The priority exponent defaults to 0.6 and the importance exponent to 0.4.
+     */
+    DiwaSampler();
+
+    /**
+     * @brief Destructor for the DiwaSampler class.
+     *
+     * Releases the trees of the sampler.
+     */
+    ~DiwaSampler();
+
+    /**
+     * @brief Initializes the sampler for a dataset.
+     *
+     * Every sample starts with the same priority.
+     *
+     * @param samples Number of samples in the dataset.
+     * @return DiwaError indicating the initialization status.
+     */
+    DiwaError initialize(int samples);
+
+    /**
+     * @brief Sets the priority exponent.
+     *
+     * A priority exponent of 0 gives uniform sampling, while 1 samples proportionally to the loss.
+     *
+     * @param alpha The exponent applied to the losses.
+     */
+    void setPriorityExponent(double alpha);
+
+    /**
+     * @brief Sets the importance weight exponent.
+     *
+     * An exponent of 1 fully corrects the bias of prioritized sampling. It is usually
+     * annealed from a lower value towards 1 over the course of training.
+     *
+     * @param beta The exponent of the importance weight correction.
+     */
+    void setImportanceExponent(double beta);
+
+    /**
+     * @brief Seeds the pseudo-random number generator of the sampler.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Records the loss of a sample.
+     *
+     * This method updates the priority of the sample in O(log n) time.
+     *
+     * @param index Index of the sample.
+     * @param loss Most recent loss of the sample.
+     */
+    void update(int index, double loss);
+
+    /**
+     * @brief Draws a sample with a probability proportional to its priority.
+     *
+     * @param weight Pointer receiving the importance weight of the drawn sample, within (0, 1], or NULL.
+     * @return Index of the drawn sample.
+     */
+    int sample(double *weight);
+
+    /**
+     * @brief Trains the network on a mini-batch of prioritized samples.
+     *
+     * This method draws `batchSize` samples, trains the network on each of them with the
+     * learning rate scaled by its importance weight, and records the loss returned by
+     * Diwa::train() as the new priority of the sample.
+     *
+     * @param network The neural network to be trained.
+     * @param learningRate Learning rate for the training process.
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param batchSize Number of samples to draw.
+     *
+     * @return The mean loss of the drawn samples.
+     */
+    double train(
+        Diwa& network,
+        double learningRate,
+        double *inputs,
+        double *targets,
+        int batchSize
+    );
+};
+
+#endif  // DIWA_SAMPLER_H
@@ -0,0 +1,409 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_search.h>
+#include <diwa_dataset.h>
+#include <diwa_metrics.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#   include <chrono>
+#endif
+
+#ifdef DIWA_THREADS
+#   include <atomic>
+#   include <thread>
+#endif
+
+#define DIWA_SEARCH_ROUNDS      5       /**< Timed rounds per candidate, the fastest one being kept */
+#define DIWA_SEARCH_ROUND_TIME  2000    /**< Minimum duration of a timed round in microseconds */
+
+// Microseconds elapsed since an arbitrary point in time
+static double timestamp() {
+    #ifdef ARDUINO
+    return (double) micros();
+    #else
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+    #endif
+}
+
+DiwaTopologySearch::DiwaTopologySearch(int threads) {
+    #ifdef DIWA_THREADS
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    threads = 1;
+    #endif
+
+    this->threads = threads > 0 ? threads : 1;
+
+    this->candidates = NULL;
+    this->candidateCount = 0;
+    this->best = -1;
+
+    this->latencyBudget = 0;
+    this->memoryBudget = 0;
+    this->weightCost = 0;
+    this->activationCost = 0;
+
+    this->activation = DiwaActivationFunc::sigmoid;
+    this->outputMode = ACTIVATION_OUTPUT;
+    this->seed = 0;
+
+    this->inputCount = 0;
+    this->outputCount = 0;
+
+    const int hiddenNeurons[] = {4, 8, 16, 32, 64};
+    this->setCandidates(hiddenNeurons, 5, 2);
+}
+
+DiwaTopologySearch::~DiwaTopologySearch() {
+    this->release();
+}
+
+void DiwaTopologySearch::release() {
+    for(int i = 0; i < this->candidateCount; i++)
+        free(this->candidates[i].weights);
+
+    free(this->candidates);
+    this->candidates = NULL;
+    this->candidateCount = 0;
+    this->best = -1;
+}
+
+DiwaError DiwaTopologySearch::setCandidates(const int *hiddenNeurons, int count, int maxHiddenLayers) {
+    if(hiddenNeurons == NULL || count <= 0 || maxHiddenLayers <= 0)
+        return INVALID_PARAM_VALUES;
+
+    for(int i = 0; i < count; i++)
+        if(hiddenNeurons[i] <= 0)
+            return INVALID_PARAM_VALUES;
+
+    Candidate *candidates = (Candidate*) calloc(count * maxHiddenLayers, sizeof(Candidate));
+    if(candidates == NULL)
+        return MALLOC_FAILED;
+
+    this->release();
+    this->candidates = candidates;
+    this->candidateCount = count * maxHiddenLayers;
+
+    for(int layers = 1; layers <= maxHiddenLayers; layers++)
+        for(int i = 0; i < count; i++) {
+            Candidate& candidate = candidates[(layers - 1) * count + i];
+
+            candidate.hiddenLayers = layers;
+            candidate.hiddenNeurons = hiddenNeurons[i];
+            candidate.accuracy = -1;
+        }
+
+    return NO_ERROR;
+}
+
+void DiwaTopologySearch::setLatencyBudget(double microseconds) {
+    this->latencyBudget = microseconds;
+}
+
+void DiwaTopologySearch::setMemoryBudget(size_t bytes) {
+    this->memoryBudget = bytes;
+}
+
+void DiwaTopologySearch::setCostModel(double weightCost, double activationCost) {
+    this->weightCost = weightCost;
+    this->activationCost = activationCost;
+}
+
+void DiwaTopologySearch::setActivationFunction(diwa_activation activation) {
+    this->activation = activation;
+}
+
+void DiwaTopologySearch::setOutputMode(DiwaOutputMode mode) {
+    this->outputMode = mode;
+}
+
+void DiwaTopologySearch::setSeed(uint64_t seed) {
+    this->seed = seed;
+}
+
+DiwaError DiwaTopologySearch::measure(Candidate& candidate, const double *inputs) const {
+    Diwa network;
+    network.setSeed(this->seed);
+    network.setActivationFunction(this->activation);
+    network.setOutputMode(this->outputMode);
+
+    candidate.memory = Diwa::getFootprint(
+        this->inputCount,
+        candidate.hiddenLayers,
+        candidate.hiddenNeurons,
+        this->outputCount
+    );
+
+    DiwaError error;
+    if((error = network.initialize(
+        this->inputCount,
+        candidate.hiddenLayers,
+        candidate.hiddenNeurons,
+        this->outputCount
+    )) != NO_ERROR)
+        return error;
+
+    if(this->weightCost > 0) {
+        candidate.latency = this->weightCost * network.getWeightCount() +
+            this->activationCost * (network.getNeuronCount() - this->inputCount);
+        return NO_ERROR;
+    }
+
+    double *sample = (double*) malloc(sizeof(double) * this->inputCount);
+    if(sample == NULL)
+        return MALLOC_FAILED;
+    memcpy(sample, inputs, sizeof(double) * this->inputCount);
+
+    // Calibrate the number of inferences per round on a single one
+    double start = timestamp();
+    network.inference(sample);
+
+    const double single = timestamp() - start;
+    const int iterations = single > 0 && single < DIWA_SEARCH_ROUND_TIME ?
+        (int) (DIWA_SEARCH_ROUND_TIME / single) + 1 : 1;
+
+    candidate.latency = HUGE_VAL;
+    for(int round = 0; round < DIWA_SEARCH_ROUNDS; round++) {
+        start = timestamp();
+        for(int i = 0; i < iterations; i++)
+            network.inference(sample);
+
+        const double latency = (timestamp() - start) / iterations;
+        if(latency < candidate.latency)
+            candidate.latency = latency;
+    }
+
+    free(sample);
+    return NO_ERROR;
+}
+
+DiwaError DiwaTopologySearch::train(
+    Candidate& candidate,
+    DiwaDataset& training,
+    const DiwaDataset& validation,
+    double learningRate,
+    int epochs,
+    int batchSize
+) const {
+    Diwa network;
+    network.setSeed(this->seed);
+    network.setActivationFunction(this->activation);
+    network.setOutputMode(this->outputMode);
+
+    DiwaError error;
+    if((error = network.initialize(
+        this->inputCount,
+        candidate.hiddenLayers,
+        candidate.hiddenNeurons,
+        this->outputCount
+    )) != NO_ERROR)
+        return error;
+
+    if((error = network.fit(learningRate, training, epochs, batchSize)) != NO_ERROR)
+        return error;
+
+    DiwaMetrics metrics;
+    if((error = network.evaluate(validation, metrics, 1)) != NO_ERROR)
+        return error;
+
+    candidate.weights = (double*) malloc(sizeof(double) * network.getWeightCount());
+    if(candidate.weights == NULL)
+        return MALLOC_FAILED;
+
+    network.getWeights(candidate.weights);
+    candidate.accuracy = metrics.getAccuracy();
+
+    return NO_ERROR;
+}
+
+DiwaError DiwaTopologySearch::search(
+    const DiwaDataset& dataset,
+    double learningRate,
+    int epochs,
+    int batchSize,
+    double validationFraction
+) {
+    if(dataset.getSampleCount() <= 0 || this->candidateCount <= 0)
+        return INVALID_PARAM_VALUES;
+
+    this->inputCount = dataset.getInputCount();
+    this->outputCount = dataset.getTargetCount();
+    this->best = -1;
+
+    for(int i = 0; i < this->candidateCount; i++) {
+        free(this->candidates[i].weights);
+
+        this->candidates[i].weights = NULL;
+        this->candidates[i].accuracy = -1;
+    }
+
+    // Measure every candidate on a single thread, so that the
+    // latencies are not disturbed by the training of the others
+    int *pending = (int*) malloc(sizeof(int) * this->candidateCount);
+    if(pending == NULL)
+        return MALLOC_FAILED;
+
+    int pendingCount = 0;
+    DiwaError error = NO_ERROR;
+
+    for(int i = 0; i < this->candidateCount && error == NO_ERROR; i++) {
+        Candidate& candidate = this->candidates[i];
+        error = this->measure(candidate, dataset.getSampleInputs(0));
+
+        if(error == NO_ERROR &&
+            (this->latencyBudget <= 0 || candidate.latency <= this->latencyBudget) &&
+            (this->memoryBudget == 0 || candidate.memory <= this->memoryBudget))
+            pending[pendingCount++] = i;
+    }
+
+    DiwaError *errors = new DiwaError[pendingCount > 0 ? pendingCount : 1];
+    for(int p = 0; p < pendingCount; p++)
+        errors[p] = NO_ERROR;
+
+    auto trainPending = [&](int p) {
+        DiwaDataset training, validation;
+
+        if((errors[p] = dataset.split(validationFraction, training, validation)) != NO_ERROR)
+            return;
+
+        training.setSeed(this->seed + 1);
+        errors[p] = this->train(
+            this->candidates[pending[p]],
+            training, validation,
+            learningRate, epochs, batchSize
+        );
+    };
+
+    if(error == NO_ERROR) {
+        #ifdef DIWA_THREADS
+        std::atomic<int> next(0);
+        auto work = [&]() {
+            for(int p; (p = next++) < pendingCount; )
+                trainPending(p);
+        };
+
+        const int threads = this->threads < pendingCount ? this->threads : pendingCount;
+        std::thread *workers = new std::thread[threads > 1 ? threads - 1 : 0];
+
+        for(int t = 1; t < threads; t++)
+            workers[t - 1] = std::thread(work);
+
+        work();
+
+        for(int t = 1; t < threads; t++)
+            workers[t - 1].join();
+        delete[] workers;
+        #else
+        for(int p = 0; p < pendingCount; p++)
+            trainPending(p);
+        #endif
+    }
+
+    for(int p = 0; p < pendingCount && error == NO_ERROR; p++)
+        error = errors[p];
+
+    // Keep the weights of the most accurate candidate only; on equal
+    // accuracy, the one needing less memory, then the faster one wins
+    for(int p = 0; p < pendingCount && error == NO_ERROR; p++) {
+        if(this->best < 0) {
+            this->best = pending[p];
+            continue;
+        }
+
+        const Candidate& candidate = this->candidates[pending[p]];
+        const Candidate& best = this->candidates[this->best];
+
+        if(candidate.accuracy > best.accuracy ||
+            (candidate.accuracy == best.accuracy &&
+            (candidate.memory < best.memory ||
+            (candidate.memory == best.memory && candidate.latency < best.latency))))
+            this->best = pending[p];
+    }
+
+    for(int i = 0; i < this->candidateCount; i++)
+        if(i != this->best) {
+            free(this->candidates[i].weights);
+            this->candidates[i].weights = NULL;
+        }
+
+    free(pending);
+    delete[] errors;
+
+    return error;
+}
+
+DiwaError DiwaTopologySearch::getBestNetwork(Diwa& network) const {
+    if(this->best < 0)
+        return INVALID_PARAM_VALUES;
+
+    const Candidate& candidate = this->candidates[this->best];
+    network.setActivationFunction(this->activation);
+    network.setOutputMode(this->outputMode);
+
+    DiwaError error;
+    if((error = network.initialize(
+        this->inputCount,
+        candidate.hiddenLayers,
+        candidate.hiddenNeurons,
+        this->outputCount,
+        false
+    )) != NO_ERROR)
+        return error;
+
+    network.setWeights(candidate.weights);
+    return NO_ERROR;
+}
+
+int DiwaTopologySearch::getBestCandidate() const {
+    return this->best;
+}
+
+int DiwaTopologySearch::getCandidateCount() const {
+    return this->candidateCount;
+}
+
+int DiwaTopologySearch::getHiddenLayers(int candidate) const {
+    return this->candidates[candidate].hiddenLayers;
+}
+
+int DiwaTopologySearch::getHiddenNeurons(int candidate) const {
+    return this->candidates[candidate].hiddenNeurons;
+}
+
+double DiwaTopologySearch::getLatency(int candidate) const {
+    return this->candidates[candidate].latency;
+}
+
+size_t DiwaTopologySearch::getMemory(int candidate) const {
+    return this->candidates[candidate].memory;
+}
+
+double DiwaTopologySearch::getAccuracy(int candidate) const {
+    return this->candidates[candidate].accuracy;
+}
@@ -0,0 +1,289 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_search.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaTopologySearch class, which
+ *        picks the most accurate network topology within a latency and memory budget.
+ *
+ * The DiwaTopologySearch class goes through a grid of candidate topologies, i.e. numbers
+ * of hidden layers and of neurons per hidden layer. The inference latency and the memory
+ * of every candidate are measured or predicted first, and the candidates over budget are
+ * discarded without being trained. The remaining candidates are trained on the same samples
+ * and evaluated on the same held-out samples, and the most accurate one is kept.
+ *
+ * The inference latency is either measured on the running machine, timing untrained
+ * networks since the latency does not depend on the weights, or predicted from a linear
+ * cost model of the target, e.g. a microcontroller. The cost model charges a cost per
+ * weight, i.e. per multiply-accumulate, and a cost per activation function call.
+ *
+ * @note On desktop platforms, the candidates are trained concurrently by a pool of worker
+ *       threads, after the latencies were measured on a single thread. On Arduino, the
+ *       candidates are measured and trained sequentially.
+ */
+
+#ifndef DIWA_SEARCH_H
+#define DIWA_SEARCH_H
+
+#include <diwa.h>
+
+/**
+ *
+ * @class DiwaTopologySearch
+ * @brief Budget-constrained search over the hidden layers
+ *        of the Diwa neural network.
+ *
+ * The grid of candidates defaults to 1 and 2 hidden layers of
+ * 4, 8, 16, 32 or 64 neurons each. Without any budget, every
+ * candidate is trained.
+ *
+ */
+class DiwaTopologySearch final {
+private:
+    /**
+     * @brief Measurements and results of a candidate topology.
+     */
+    struct Candidate {
+        int hiddenLayers;       /**< Number of hidden layers */
+        int hiddenNeurons;      /**< Number of neurons per hidden layer */
+        double latency;         /**< Measured or predicted inference latency in microseconds */
+        size_t memory;          /**< Bytes of memory needed for inference */
+        double accuracy;        /**< Accuracy on the held-out samples, or -1 if not trained */
+        double *weights;        /**< Trained weights, kept for the best candidate only */
+    };
+
+    Candidate *candidates;  /**< Candidates of the grid */
+    int candidateCount;     /**< Number of candidates */
+    int best;               /**< Index of the most accurate candidate within budget, or -1 */
+    int threads;            /**< Number of worker threads */
+
+    double latencyBudget;   /**< Maximum inference latency in microseconds, or 0 */
+    size_t memoryBudget;    /**< Maximum inference memory in bytes, or 0 */
+    double weightCost;      /**< Predicted cost of a weight in microseconds, or 0 to measure */
+    double activationCost;  /**< Predicted cost of an activation in microseconds */
+
+    diwa_activation activation; /**< Activation function of the candidates */
+    DiwaOutputMode outputMode;  /**< Output mode of the candidates */
+    uint64_t seed;              /**< Seed of the weights and of the shuffling */
+
+    int inputCount;         /**< Number of inputs of the last searched dataset */
+    int outputCount;        /**< Number of outputs of the last searched dataset */
+
+    /**
+     * @brief Releases the candidates.
+     */
+    void release();
+
+    /**
+     * @brief Measures or predicts the latency and memory of a candidate.
+     *
+     * @param candidate The candidate, with its topology set.
+     * @param inputs Input values of a sample.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError measure(Candidate& candidate, const double *inputs) const;
+
+    /**
+     * @brief Trains a candidate and evaluates it on the held-out samples.
+     *
+     * @param candidate The candidate.
+     * @param training Training samples.
+     * @param validation Held-out samples.
+     * @param learningRate Learning rate for the training process.
+     * @param epochs Number of passes over the training samples.
+     * @param batchSize Number of samples per batch.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError train(
+        Candidate& candidate,
+        DiwaDataset& training,
+        const DiwaDataset& validation,
+        double learningRate,
+        int epochs,
+        int batchSize
+    ) const;
+
+public:
+    /**
+     * @brief Constructor for the DiwaTopologySearch class.
+     *
+     * @param threads Number of worker threads, or 0 for one per hardware thread.
+     */
+    DiwaTopologySearch(int threads = 0);
+
+    /**
+     * @brief Destructor for the DiwaTopologySearch class.
+     *
+     * Releases the candidates and the weights of the best one.
+     */
+    ~DiwaTopologySearch();
+
+    /**
+     * @brief Sets the grid of candidate topologies.
+     *
+     * Every number of hidden layers from 1 to `maxHiddenLayers` is combined with
+     * every number of hidden neurons.
+     *
+     * @param hiddenNeurons Numbers of neurons per hidden layer to try.
+     * @param count Number of values in hiddenNeurons.
+     * @param maxHiddenLayers Highest number of hidden layers to try.
+     * @return DiwaError indicating the status of the operation.
+     */
+    DiwaError setCandidates(const int *hiddenNeurons, int count, int maxHiddenLayers);
+
+    /**
+     * @brief Sets the maximum inference latency.
+     *
+     * @param microseconds Maximum latency of an inference, or 0 for no limit.
+     */
+    void setLatencyBudget(double microseconds);
+
+    /**
+     * @brief Sets the maximum memory needed for inference.
+     *
+     * The memory of a candidate is its inference footprint, as given by Diwa::getFootprint().
+     *
+     * @param bytes Maximum memory in bytes, or 0 for no limit.
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * @brief Predicts the latency from a cost model instead of measuring it.
+     *
+     * @param weightCost Cost of a weight, i.e. of a multiply-accumulate, in microseconds,
+     *        or 0 to measure the latency on the running machine.
+     * @param activationCost Cost of an activation function call in microseconds.
+     */
+    void setCostModel(double weightCost, double activationCost);
+
+    /**
+     * @brief Sets the activation function of the candidates.
+     *
+     * @param activation The activation function, with a derivative known to DiwaActivationFunc::derivativeOf().
+     */
+    void setActivationFunction(diwa_activation activation);
+
+    /**
+     * @brief Sets the output mode of the candidates.
+     *
+     * @param mode The output mode.
+     */
+    void setOutputMode(DiwaOutputMode mode);
+
+    /**
+     * @brief Sets the seed of the weights and of the shuffling of every candidate.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Searches the most accurate candidate within budget.
+     *
+     * The first samples of the current order of the dataset train every candidate,
+     * and the rest evaluate them, so the dataset should be shuffled beforehand. Among
+     * equally accurate candidates, the one needing the least memory is kept, and then
+     * the one with the lowest latency.
+     *
+     * @param dataset The dataset.
+     * @param learningRate Learning rate for the training process.
+     * @param epochs Number of passes over the training samples.
+     * @param batchSize Number of samples per batch.
+     * @param validationFraction Fraction of the samples held out for evaluation, within (0, 1).
+     * @return DiwaError indicating the status of the search. Finding no candidate within
+     *         budget is not an error; getBestCandidate() then returns -1.
+     */
+    DiwaError search(
+        const DiwaDataset& dataset,
+        double learningRate,
+        int epochs,
+        int batchSize,
+        double validationFraction = 0.2
+    );
+
+    /**
+     * @brief Initializes a network with the best topology and its trained weights.
+     *
+     * @param network The neural network to initialize.
+     * @return DiwaError indicating the status of the operation, INVALID_PARAM_VALUES if
+     *         no candidate was found within budget.
+     */
+    DiwaError getBestNetwork(Diwa& network) const;
+
+    /**
+     * @brief Get the index of the most accurate candidate within budget.
+     *
+     * @return The index of the candidate, or -1 if no candidate was within budget.
+     */
+    int getBestCandidate() const;
+
+    /**
+     * @brief Get the number of candidates of the grid.
+     *
+     * @return The number of candidates.
+     */
+    int getCandidateCount() const;
+
+    /**
+     * @brief Get the number of hidden layers of a candidate.
+     *
+     * @param candidate Index of the candidate.
+     * @return The number of hidden layers.
+     */
+    int getHiddenLayers(int candidate) const;
+
+    /**
+     * @brief Get the number of neurons per hidden layer of a candidate.
+     *
+     * @param candidate Index of the candidate.
+     * @return The number of neurons per hidden layer.
+     */
+    int getHiddenNeurons(int candidate) const;
+
+    /**
+     * @brief Get the inference latency of a candidate.
+     *
+     * @param candidate Index of the candidate.
+     * @return The measured or predicted latency in microseconds.
+     */
+    double getLatency(int candidate) const;
+
+    /**
+     * @brief Get the memory needed for inference by a candidate.
+     *
+     * @param candidate Index of the candidate.
+     * @return The memory in bytes.
+     */
+    size_t getMemory(int candidate) const;
+
+    /**
+     * @brief Get the accuracy of a candidate on the held-out samples.
+     *
+     * @param candidate Index of the candidate.
+     * @return The accuracy, or -1 if the candidate was over budget and not trained.
+     */
+    double getAccuracy(int candidate) const;
+};
+
+#endif  // DIWA_SEARCH_H
@@ -0,0 +1,691 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_trainer.h>
+#include <diwa_conv.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#   define M_PI 3.14159265358979323846
+#endif
+
+#define DIWA_TRAINER_STATE_SIZE (4 * 8 + 8 * 8 + 8 * 9) /**< Size of the fixed part of the trainer state */
+
+static inline void putInt(uint8_t *&buffer, int value) {
+    uint8_t *bytes = DiwaConv::intToU8a(value);
+
+    memcpy(buffer, bytes, 4);
+    buffer += 4;
+    delete[] bytes;
+}
+
+static inline void putDouble(uint8_t *&buffer, double value) {
+    uint8_t *bytes = DiwaConv::doubleToU8a(value);
+
+    memcpy(buffer, bytes, 8);
+    buffer += 8;
+    delete[] bytes;
+}
+
+static inline void putUint64(uint8_t *&buffer, uint64_t value) {
+    putInt(buffer, (int) (uint32_t) value);
+    putInt(buffer, (int) (uint32_t) (value >> 32));
+}
+
+static inline int getInt(const uint8_t *&buffer) {
+    int value = DiwaConv::u8aToInt((uint8_t*) buffer);
+
+    buffer += 4;
+    return value;
+}
+
+static inline double getDouble(const uint8_t *&buffer) {
+    double value = DiwaConv::u8aToDouble((uint8_t*) buffer);
+
+    buffer += 8;
+    return value;
+}
+
+static inline uint64_t getUint64(const uint8_t *&buffer) {
+    uint64_t low = (uint32_t) getInt(buffer);
+    return low | ((uint64_t) (uint32_t) getInt(buffer) << 32);
+}
+
+DiwaTrainer::DiwaTrainer(Diwa& network) {
+    this->network = &network;
+
+    this->schedule = CONSTANT_SCHEDULE;
+    this->learningRate = 1.0;
+    this->minLearningRate = 0.0;
+    this->stepFactor = 1.0;
+    this->stepSize = 1;
+    this->warmupFraction = 0.3;
+
+    this->patience = 0;
+    this->minImprovement = 0.0;
+
+    this->bestWeights = NULL;
+    this->bestWeightCount = 0;
+
+    this->epoch = 0;
+    this->bestEpoch = 0;
+    this->bestLoss = 0.0;
+
+    this->cursor = 0;
+    this->epochLoss = 0.0;
+    this->step = 0;
+
+    this->shuffle = false;
+    this->order = NULL;
+    this->orderCount = 0;
+
+    this->checkpoint = NULL;
+    this->checkpointInterval = 0;
+}
+
+DiwaTrainer::~DiwaTrainer() {
+    free(this->bestWeights);
+    free(this->order);
+}
+
+void DiwaTrainer::setLearningRate(double learningRate) {
+    this->learningRate = learningRate;
+}
+
+void DiwaTrainer::setConstantSchedule() {
+    this->schedule = CONSTANT_SCHEDULE;
+}
+
+void DiwaTrainer::setStepSchedule(int stepSize, double factor) {
+    this->schedule = STEP_SCHEDULE;
+    this->stepSize = stepSize > 0 ? stepSize : 1;
+    this->stepFactor = factor;
+}
+
+void DiwaTrainer::setCosineSchedule(double minLearningRate) {
+    this->schedule = COSINE_SCHEDULE;
+    this->minLearningRate = minLearningRate;
+}
+
+void DiwaTrainer::setOneCycleSchedule(double minLearningRate, double warmupFraction) {
+    this->schedule = ONE_CYCLE_SCHEDULE;
+    this->minLearningRate = minLearningRate;
+    this->warmupFraction = warmupFraction;
+}
+
+void DiwaTrainer::setEarlyStopping(int patience, double minImprovement) {
+    this->patience = patience > 0 ? patience : 0;
+    this->minImprovement = minImprovement;
+}
+
+void DiwaTrainer::setShuffle(bool shuffle) {
+    this->shuffle = shuffle;
+}
+
+void DiwaTrainer::setSeed(uint64_t seed) {
+    this->randomizer.seed(seed);
+}
+
+void DiwaTrainer::setCheckpointCallback(diwa_checkpoint callback, int interval) {
+    this->checkpoint = callback;
+    this->checkpointInterval = interval > 0 ? interval : 1;
+}
+
+double DiwaTrainer::getLearningRate(int epoch, int epochs) const {
+    const double progress = epochs > 1 ?
+        (double) epoch / (epochs - 1) : 1.0;
+
+    switch(this->schedule) {
+        case STEP_SCHEDULE:
+            return this->learningRate *
+                pow(this->stepFactor, epoch / this->stepSize);
+
+        case COSINE_SCHEDULE:
+            return this->minLearningRate +
+                0.5 * (this->learningRate - this->minLearningRate) *
+                (1.0 + cos(M_PI * progress));
+
+        case ONE_CYCLE_SCHEDULE:
+            if(progress < this->warmupFraction)
+                return this->minLearningRate +
+                    (this->learningRate - this->minLearningRate) *
+                    progress / this->warmupFraction;
+
+            return this->minLearningRate +
+                0.5 * (this->learningRate - this->minLearningRate) *
+                (1.0 + cos(M_PI * (progress - this->warmupFraction) /
+                    (1.0 - this->warmupFraction)));
+
+        default:
+            return this->learningRate;
+    }
+}
+
+double DiwaTrainer::datasetLoss(double *inputs, double *targets, int samples) {
+    const int inputCount = this->network->getInputNeurons();
+    const int outputCount = this->network->getOutputNeurons();
+    const bool softmax = this->network->getOutputMode() == SOFTMAX_OUTPUT;
+
+    double loss = 0.0;
+    for(int i = 0; i < samples; i++) {
+        double *outputs = this->network->inference(inputs + i * inputCount);
+        double *target = targets + i * outputCount;
+
+        for(int j = 0; j < outputCount; j++)
+            if(softmax) {
+                if(target[j] != 0)
+                    loss -= target[j] * log(outputs[j] > 1e-12 ? outputs[j] : 1e-12);
+            }
+            else loss += 0.5 * (target[j] - outputs[j]) * (target[j] - outputs[j]);
+    }
+
+    return loss / samples;
+}
+
+double DiwaTrainer::findLearningRate(
+    double *inputs,
+    double *targets,
+    int samples,
+    double minRate,
+    double maxRate,
+    int steps
+) {
+    if(samples <= 0 || steps < 2 ||
+        minRate <= 0 || maxRate <= minRate)
+        return -1;
+
+    const int inputCount = this->network->getInputNeurons();
+    const int outputCount = this->network->getOutputNeurons();
+
+    double *initialWeights = (double*) malloc(
+        sizeof(double) * this->network->getWeightCount()
+    );
+    if(initialWeights == NULL)
+        return -1;
+    this->network->getWeights(initialWeights);
+
+    double smoothedLoss = 0.0, lowestLoss = 0.0, bestRate = minRate;
+    for(int i = 0; i < steps; i++) {
+        const double rate = minRate * pow(maxRate / minRate, (double) i / (steps - 1));
+        const int sample = i % samples;
+
+        double loss = this->network->train(
+            rate,
+            inputs + (size_t) sample * inputCount,
+            targets + (size_t) sample * outputCount
+        );
+
+        smoothedLoss = 0.98 * smoothedLoss + 0.02 * loss;
+        loss = smoothedLoss / (1.0 - pow(0.98, i + 1));
+
+        if(isnan(loss) || (i > 0 && loss > 4 * lowestLoss))
+            break;
+
+        if(i == 0 || loss < lowestLoss) {
+            lowestLoss = loss;
+            bestRate = rate;
+        }
+    }
+
+    this->network->setWeights(initialWeights);
+    free(initialWeights);
+
+    return bestRate / 10;
+}
+
+DiwaError DiwaTrainer::fit(
+    double *trainInputs,
+    double *trainTargets,
+    int trainSamples,
+    double *validationInputs,
+    double *validationTargets,
+    int validationSamples,
+    int epochs
+) {
+    this->epoch = 0;
+    this->bestEpoch = -1;
+    this->cursor = 0;
+    this->epochLoss = 0.0;
+    this->step = 0;
+
+    return this->resume(
+        trainInputs, trainTargets, trainSamples,
+        validationInputs, validationTargets, validationSamples,
+        epochs
+    );
+}
+
+DiwaError DiwaTrainer::resume(
+    double *trainInputs,
+    double *trainTargets,
+    int trainSamples,
+    double *validationInputs,
+    double *validationTargets,
+    int validationSamples,
+    int epochs
+) {
+    if(trainSamples <= 0 || epochs <= 0 ||
+        this->cursor > trainSamples ||
+        this->network->getWeightCount() <= 0)
+        return INVALID_PARAM_VALUES;
+
+    if(this->bestWeightCount < this->network->getWeightCount()) {
+        double *buffer = (double*) realloc(
+            this->bestWeights,
+            sizeof(double) * this->network->getWeightCount()
+        );
+
+        if(buffer == NULL)
+            return MALLOC_FAILED;
+
+        this->bestWeights = buffer;
+        this->bestWeightCount = this->network->getWeightCount();
+    }
+
+    if(this->shuffle && this->orderCount != trainSamples) {
+        if(this->cursor > 0)
+            return INVALID_PARAM_VALUES;
+
+        int *buffer = (int*) realloc(this->order, sizeof(int) * trainSamples);
+        if(buffer == NULL)
+            return MALLOC_FAILED;
+
+        this->order = buffer;
+        this->orderCount = trainSamples;
+    }
+
+    const int inputCount = this->network->getInputNeurons();
+    const int outputCount = this->network->getOutputNeurons();
+    const bool validate = validationInputs != NULL &&
+        validationTargets != NULL &&
+        validationSamples > 0;
+
+    while(this->epoch < epochs) {
+        if(this->patience && this->bestEpoch >= 0 &&
+            this->epoch - this->bestEpoch > this->patience)
+            break;
+
+        const double rate = this->getLearningRate(this->epoch, epochs);
+
+        if(this->shuffle && this->cursor == 0) {
+            for(int i = 0; i < trainSamples; i++)
+                this->order[i] = i;
+
+            for(int i = trainSamples - 1; i > 0; i--) {
+                const int j = (int) (this->randomizer.next() % (uint64_t) (i + 1));
+                const int sample = this->order[i];
+
+                this->order[i] = this->order[j];
+                this->order[j] = sample;
+            }
+        }
+
+        while(this->cursor < trainSamples) {
+            const int sample = this->shuffle ?
+                this->order[this->cursor] : this->cursor;
+
+            this->epochLoss += this->network->train(
+                rate,
+                trainInputs + (size_t) sample * inputCount,
+                trainTargets + (size_t) sample * outputCount
+            );
+
+            this->cursor++;
+            this->step++;
+
+            if(this->checkpoint != NULL &&
+                this->step % this->checkpointInterval == 0 &&
+                !this->checkpoint(*this))
+                return TRAINING_INTERRUPTED;
+        }
+
+        const double loss = validate ?
+            this->datasetLoss(validationInputs, validationTargets, validationSamples) :
+            this->epochLoss / trainSamples;
+
+        if(this->bestEpoch < 0 || loss < this->bestLoss - this->minImprovement) {
+            this->bestLoss = loss;
+            this->bestEpoch = this->epoch;
+            this->network->getWeights(this->bestWeights);
+        }
+
+        this->epoch++;
+        this->cursor = 0;
+        this->epochLoss = 0.0;
+    }
+
+    if(this->bestEpoch >= 0)
+        this->network->setWeights(this->bestWeights);
+    return NO_ERROR;
+}
+
+int DiwaTrainer::stateSize() const {
+    const int residualCount = this->network->residuals != NULL ?
+        this->network->weightCount : 0;
+    const int bestCount = this->bestEpoch >= 0 ? this->network->weightCount : 0;
+    const int layerCount = this->network->firstTrainable > 0 ?
+        this->network->hiddenLayers + 1 : 0;
+    const int orderCount = this->shuffle ? this->orderCount : 0;
+
+    return DIWA_TRAINER_STATE_SIZE +
+        8 * (bestCount + residualCount) +
+        layerCount +
+        4 * orderCount;
+}
+
+void DiwaTrainer::writeState(uint8_t *buffer) const {
+    const int residualCount = this->network->residuals != NULL ?
+        this->network->weightCount : 0;
+    const int bestCount = this->bestEpoch >= 0 ? this->network->weightCount : 0;
+    const int layerCount = this->network->firstTrainable > 0 ?
+        this->network->hiddenLayers + 1 : 0;
+    const int orderCount = this->shuffle ? this->orderCount : 0;
+
+    putInt(buffer, this->schedule);
+    putInt(buffer, this->stepSize);
+    putInt(buffer, this->patience);
+    putInt(buffer, this->epoch);
+    putInt(buffer, this->bestEpoch);
+    putInt(buffer, this->cursor);
+    putInt(buffer,
+        (bestCount ? 1 : 0) |
+        (residualCount ? 2 : 0) |
+        (orderCount ? 4 : 0) |
+        (layerCount ? 8 : 0)
+    );
+    putInt(buffer, orderCount);
+
+    putDouble(buffer, this->learningRate);
+    putDouble(buffer, this->minLearningRate);
+    putDouble(buffer, this->stepFactor);
+    putDouble(buffer, this->warmupFraction);
+    putDouble(buffer, this->minImprovement);
+    putDouble(buffer, this->bestLoss);
+    putDouble(buffer, this->epochLoss);
+    putDouble(buffer, this->network->updateThreshold);
+
+    uint64_t state[4];
+    putUint64(buffer, this->step);
+
+    this->randomizer.getState(state);
+    for(int i = 0; i < 4; i++)
+        putUint64(buffer, state[i]);
+
+    this->network->randomizer.getState(state);
+    for(int i = 0; i < 4; i++)
+        putUint64(buffer, state[i]);
+
+    for(int i = 0; i < bestCount; i++)
+        putDouble(buffer, this->bestWeights[i]);
+
+    for(int i = 0; i < residualCount; i++)
+        putDouble(buffer, this->network->residuals[i]);
+
+    for(int h = 0; h < layerCount; h++)
+        *buffer++ = this->network->trainableLayers[h] ? 1 : 0;
+
+    for(int i = 0; i < orderCount; i++)
+        putInt(buffer, this->order[i]);
+}
+
+DiwaError DiwaTrainer::readState(const uint8_t *buffer, int length) {
+    if(length < DIWA_TRAINER_STATE_SIZE)
+        return MODEL_READ_ERROR;
+
+    const int schedule = getInt(buffer);
+    const int stepSize = getInt(buffer);
+    const int patience = getInt(buffer);
+    const int epoch = getInt(buffer);
+    const int bestEpoch = getInt(buffer);
+    const int cursor = getInt(buffer);
+    const int flags = getInt(buffer);
+    const int orderCount = getInt(buffer);
+
+    const double learningRate = getDouble(buffer);
+    const double minLearningRate = getDouble(buffer);
+    const double stepFactor = getDouble(buffer);
+    const double warmupFraction = getDouble(buffer);
+    const double minImprovement = getDouble(buffer);
+    const double bestLoss = getDouble(buffer);
+    const double epochLoss = getDouble(buffer);
+    const double updateThreshold = getDouble(buffer);
+
+    const int weightCount = this->network->weightCount;
+    const int layerCount = this->network->hiddenLayers + 1;
+
+    if(schedule < CONSTANT_SCHEDULE || schedule > ONE_CYCLE_SCHEDULE ||
+        epoch < 0 || cursor < 0 || orderCount < 0 ||
+        ((flags & 1) != 0) != (bestEpoch >= 0) ||
+        ((flags & 4) != 0) != (orderCount > 0) ||
+        ((flags & 4) && cursor > orderCount) ||
+        length != DIWA_TRAINER_STATE_SIZE +
+            ((flags & 1) ? 8 * weightCount : 0) +
+            ((flags & 2) ? 8 * weightCount : 0) +
+            ((flags & 8) ? layerCount : 0) +
+            4 * orderCount)
+        return MODEL_READ_ERROR;
+
+    if((flags & 1) && this->bestWeightCount < weightCount) {
+        double *weights = (double*) realloc(this->bestWeights, sizeof(double) * weightCount);
+        if(weights == NULL)
+            return MALLOC_FAILED;
+
+        this->bestWeights = weights;
+        this->bestWeightCount = weightCount;
+    }
+
+    if((flags & 2) && this->network->residuals == NULL) {
+        this->network->residuals = (double*) calloc(weightCount, sizeof(double));
+        if(this->network->residuals == NULL)
+            return MALLOC_FAILED;
+    }
+
+    if((flags & 4) && this->orderCount != orderCount) {
+        int *order = (int*) realloc(this->order, sizeof(int) * orderCount);
+        if(order == NULL)
+            return MALLOC_FAILED;
+
+        this->order = order;
+        this->orderCount = orderCount;
+    }
+
+    this->schedule = (DiwaSchedule) schedule;
+    this->stepSize = stepSize;
+    this->patience = patience;
+    this->epoch = epoch;
+    this->bestEpoch = bestEpoch;
+    this->cursor = cursor;
+
+    this->learningRate = learningRate;
+    this->minLearningRate = minLearningRate;
+    this->stepFactor = stepFactor;
+    this->warmupFraction = warmupFraction;
+    this->minImprovement = minImprovement;
+    this->bestLoss = bestLoss;
+    this->epochLoss = epochLoss;
+    this->network->updateThreshold = updateThreshold;
+    this->shuffle = (flags & 4) != 0;
+
+    uint64_t state[4];
+    this->step = getUint64(buffer);
+
+    for(int i = 0; i < 4; i++)
+        state[i] = getUint64(buffer);
+    this->randomizer.setState(state);
+
+    for(int i = 0; i < 4; i++)
+        state[i] = getUint64(buffer);
+    this->network->randomizer.setState(state);
+
+    if(flags & 1)
+        for(int i = 0; i < weightCount; i++)
+            this->bestWeights[i] = getDouble(buffer);
+
+    if(flags & 2)
+        for(int i = 0; i < weightCount; i++)
+            this->network->residuals[i] = getDouble(buffer);
+
+    // Loading the model made every layer trainable again
+    if(flags & 8)
+        for(int h = 0; h < layerCount; h++)
+            this->network->setLayerTrainable(h, *buffer++ != 0);
+
+    for(int i = 0; i < orderCount; i++)
+        this->order[i] = getInt(buffer);
+
+    return NO_ERROR;
+}
+
+#ifdef ARDUINO
+
+DiwaError DiwaTrainer::loadCheckpoint(File checkpointFile) {
+    DiwaError error;
+    if((error = this->network->loadFromFile(checkpointFile)) != NO_ERROR)
+        return error;
+
+    checkpointFile.seek(28 + 8 * this->network->weightCount);
+
+    uint8_t tag[4], temp_int[4];
+    while(checkpointFile.read(tag, 4) == 4 &&
+        checkpointFile.read(temp_int, 4) == 4) {
+        const int length = DiwaConv::u8aToInt(temp_int);
+
+        if(memcmp(tag, "trnr", 4) != 0) {
+            checkpointFile.seek(checkpointFile.position() + length);
+            continue;
+        }
+
+        uint8_t *buffer = (uint8_t*) malloc(length > 0 ? length : 1);
+        if(buffer == NULL)
+            return MALLOC_FAILED;
+
+        error = checkpointFile.read(buffer, length) == (size_t) length ?
+            this->readState(buffer, length) : MODEL_READ_ERROR;
+
+        free(buffer);
+        return error;
+    }
+
+    return MODEL_READ_ERROR;
+}
+
+DiwaError DiwaTrainer::saveCheckpoint(File checkpointFile) {
+    DiwaError error;
+    if((error = this->network->saveToFile(checkpointFile)) != NO_ERROR)
+        return error;
+
+    const int length = this->stateSize();
+    uint8_t *buffer = (uint8_t*) malloc(length);
+    if(buffer == NULL)
+        return MALLOC_FAILED;
+    this->writeState(buffer);
+
+    uint8_t *size = DiwaConv::intToU8a(length);
+    checkpointFile.write((const uint8_t*) "trnr", 4);
+    checkpointFile.write(size, 4);
+    checkpointFile.write(buffer, length);
+    checkpointFile.flush();
+
+    delete[] size;
+    free(buffer);
+
+    return NO_ERROR;
+}
+
+#elif defined(__GNUC__) || \
+    defined(__GNUG__) || \
+    defined(__clang__) || \
+    defined(_MSC_VER)
+
+DiwaError DiwaTrainer::loadCheckpoint(std::ifstream& checkpointFile) {
+    DiwaError error;
+    if((error = this->network->loadFromFile(checkpointFile)) != NO_ERROR)
+        return error;
+
+    checkpointFile.clear();
+    checkpointFile.seekg(28 + 8 * (std::streamoff) this->network->weightCount);
+
+    uint8_t tag[4], temp_int[4];
+    while(checkpointFile.read(reinterpret_cast<char*>(tag), 4) &&
+        checkpointFile.read(reinterpret_cast<char*>(temp_int), 4)) {
+        const int length = DiwaConv::u8aToInt(temp_int);
+
+        if(memcmp(tag, "trnr", 4) != 0) {
+            checkpointFile.seekg(length, std::ios::cur);
+            continue;
+        }
+
+        uint8_t *buffer = (uint8_t*) malloc(length > 0 ? length : 1);
+        if(buffer == NULL)
+            return MALLOC_FAILED;
+
+        error = checkpointFile.read(reinterpret_cast<char*>(buffer), length) ?
+            this->readState(buffer, length) : MODEL_READ_ERROR;
+
+        free(buffer);
+        return error;
+    }
+
+    return MODEL_READ_ERROR;
+}
+
+DiwaError DiwaTrainer::saveCheckpoint(std::ofstream& checkpointFile) {
+    DiwaError error;
+    if((error = this->network->saveToFile(checkpointFile)) != NO_ERROR)
+        return error;
+
+    const int length = this->stateSize();
+    uint8_t *buffer = (uint8_t*) malloc(length);
+    if(buffer == NULL)
+        return MALLOC_FAILED;
+    this->writeState(buffer);
+
+    uint8_t *size = DiwaConv::intToU8a(length);
+    checkpointFile.write("trnr", 4);
+    checkpointFile.write(reinterpret_cast<const char*>(size), 4);
+    checkpointFile.write(reinterpret_cast<const char*>(buffer), length);
+
+    delete[] size;
+    free(buffer);
+
+    return checkpointFile ? NO_ERROR : MODEL_SAVE_ERROR;
+}
+
+#endif
+
+int DiwaTrainer::getEpoch() const {
+    return this->epoch;
+}
+
+int DiwaTrainer::getBestEpoch() const {
+    return this->bestEpoch;
+}
+
+double DiwaTrainer::getBestLoss() const {
+    return this->bestLoss;
+}
+
+uint64_t DiwaTrainer::getStep() const {
+    return this->step;
+}
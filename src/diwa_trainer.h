@@ -0,0 +1,429 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_trainer.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaTrainer class, a training
+ *        driver for the Diwa neural network.
+ *
+ * The DiwaTrainer class runs the epoch loop on behalf of the caller. It varies the
+ * learning rate over the epochs using step, cosine or one-cycle schedules, can find
+ * a suitable learning rate with a learning rate range test, and stops training once
+ * the validation loss stops improving, restoring the weights of the best epoch.
+ *
+ * @note Datasets are passed as contiguous row-major arrays, i.e. the input values of
+ *       sample `i` start at `inputs + i * getInputNeurons()` and its target values at
+ *       `targets + i * getOutputNeurons()`, which is the layout of two-dimensional
+ *       arrays such as `double trainingInput[4][2]`.
+ *
+ * Training can be checkpointed at any step. A checkpoint is a regular model file followed
+ * by a `trnr` section holding the state of the trainer: the schedule, the epoch, step and
+ * sample counters, the best weights, the residuals of sparse updates, the trainable layers
+ * and the states of the pseudo-random number generators. Resuming from a checkpoint
+ * continues training exactly where it was stopped, giving the same weights as an
+ * uninterrupted run.
+ */
+
+#ifndef DIWA_TRAINER_H
+#define DIWA_TRAINER_H
+
+#include <diwa.h>
+
+/**
+ * @enum DiwaSchedule
+ * @brief Enumeration representing the learning rate
+ *        schedules supported by the DiwaTrainer class.
+ */
+typedef enum {
+    CONSTANT_SCHEDULE,      /**< Learning rate stays the same on every epoch */
+    STEP_SCHEDULE,          /**< Learning rate is multiplied by a factor every few epochs */
+    COSINE_SCHEDULE,        /**< Learning rate follows a half cosine down to a minimum */
+    ONE_CYCLE_SCHEDULE,     /**< Learning rate warms up to its maximum, then anneals to a minimum */
+} DiwaSchedule;
+
+class DiwaTrainer;
+
+/**
+ * @brief Function pointer type for checkpoint callbacks.
+ *
+ * A checkpoint callback is invoked by DiwaTrainer::fit() and DiwaTrainer::resume() every
+ * few training steps, usually to save a checkpoint of the trainer.
+ *
+ * @param trainer The trainer being run.
+ * @return True to continue training, false to interrupt it.
+ */
+typedef bool (*diwa_checkpoint)(DiwaTrainer& trainer);
+
+/**
+ *
+ * @class DiwaTrainer
+ * @brief Training driver with learning rate schedules,
+ *        learning rate range test and early stopping.
+ *
+ * The DiwaTrainer class trains a Diwa neural network over
+ * a whole dataset for a number of epochs. The learning rate
+ * of each epoch is determined by the selected schedule. When
+ * validation data is given, the weights of the epoch with the
+ * lowest validation loss are kept in a side buffer and restored
+ * when training ends, and training stops early once the loss has
+ * not improved for a configurable number of epochs.
+ *
+ */
+class DiwaTrainer final {
+private:
+    Diwa *network;          /**< Neural network being trained */
+
+    DiwaSchedule schedule;  /**< Learning rate schedule */
+    double learningRate;    /**< Base (or maximum) learning rate */
+    double minLearningRate; /**< Minimum learning rate of the cosine and one-cycle schedules */
+    double stepFactor;      /**< Factor applied to the learning rate by the step schedule */
+    int stepSize;           /**< Number of epochs between two steps of the step schedule */
+    double warmupFraction;  /**< Fraction of the epochs used for warm-up by the one-cycle schedule */
+
+    int patience;           /**< Number of epochs without improvement before stopping, 0 to disable */
+    double minImprovement;  /**< Minimum decrease of the loss counted as an improvement */
+
+    double *bestWeights;    /**< Side buffer holding the weights of the best epoch */
+    int bestWeightCount;    /**< Number of weights the side buffer can hold */
+
+    int epoch;              /**< Number of epochs run by the last call to fit() */
+    int bestEpoch;          /**< Epoch with the lowest loss on the last call to fit() */
+    double bestLoss;        /**< Lowest loss reached on the last call to fit() */
+
+    int cursor;             /**< Number of samples already trained on in the current epoch */
+    double epochLoss;       /**< Sum of the training losses of the current epoch */
+    uint64_t step;          /**< Number of training steps since the start of fit() */
+
+    bool shuffle;           /**< Whether the training samples are shuffled on every epoch */
+    int *order;             /**< Order of the training samples in the current epoch */
+    int orderCount;         /**< Number of samples the order buffer can hold */
+    DiwaRandom randomizer;  /**< Pseudo-random number generator used for shuffling */
+
+    diwa_checkpoint checkpoint; /**< Checkpoint callback, or NULL */
+    int checkpointInterval;     /**< Number of training steps between two checkpoint callbacks */
+
+    /**
+     * @brief Computes the size of the trainer section of a checkpoint.
+     *
+     * @return Size of the section payload in bytes.
+     */
+    int stateSize() const;
+
+    /**
+     * @brief Serializes the state of the trainer.
+     *
+     * @param buffer Array of at least stateSize() bytes receiving the state.
+     */
+    void writeState(uint8_t *buffer) const;
+
+    /**
+     * @brief Restores the state of the trainer.
+     *
+     * @param buffer Array holding the state written by writeState().
+     * @param length Length of the state in bytes.
+     * @return DiwaError indicating the restoration status.
+     */
+    DiwaError readState(const uint8_t *buffer, int length);
+
+    /**
+     * @brief Computes the mean loss of the network over a dataset.
+     *
+     * @param inputs Contiguous input values of the dataset.
+     * @param targets Contiguous target values of the dataset.
+     * @param samples Number of samples in the dataset.
+     * @return The mean loss over the dataset, using the loss of the network's output mode.
+     */
+    double datasetLoss(double *inputs, double *targets, int samples);
+
+public:
+    /**
+     * @brief Constructs a trainer for the given neural network.
+     *
+     * The trainer starts with a constant learning rate of 1.0 and early stopping disabled.
+     *
+     * @param network The neural network to be trained. It must outlive the trainer.
+     */
+    DiwaTrainer(Diwa& network);
+
+    /**
+     * @brief Destructor for the DiwaTrainer class.
+     *
+     * Releases the side buffer holding the best weights and the sample order.
+     */
+    ~DiwaTrainer();
+
+    /**
+     * @brief Sets the base learning rate.
+     *
+     * This is the learning rate of the constant schedule, the initial learning rate of the
+     * step and cosine schedules, and the peak learning rate of the one-cycle schedule.
+     *
+     * @param learningRate The base learning rate.
+     */
+    void setLearningRate(double learningRate);
+
+    /**
+     * @brief Keeps the learning rate constant on every epoch.
+     */
+    void setConstantSchedule();
+
+    /**
+     * @brief Multiplies the learning rate by a factor every few epochs.
+     *
+     * @param stepSize Number of epochs between two steps.
+     * @param factor Factor applied to the learning rate on every step, e.g. 0.5.
+     */
+    void setStepSchedule(int stepSize, double factor);
+
+    /**
+     * @brief Anneals the learning rate along a half cosine.
+     *
+     * The learning rate starts at the base learning rate and smoothly decreases to the
+     * given minimum on the last epoch.
+     *
+     * @param minLearningRate The learning rate of the last epoch.
+     */
+    void setCosineSchedule(double minLearningRate);
+
+    /**
+     * @brief Uses the one-cycle learning rate policy.
+     *
+     * The learning rate linearly increases from the minimum to the base learning rate
+     * during the warm-up epochs, then anneals back to the minimum along a half cosine.
+     *
+     * @param minLearningRate The learning rate of the first and last epochs.
+     * @param warmupFraction Fraction of the epochs used for warm-up, e.g. 0.3.
+     */
+    void setOneCycleSchedule(double minLearningRate, double warmupFraction);
+
+    /**
+     * @brief Enables validation-based early stopping.
+     *
+     * Training stops once the loss has not decreased by at least `minImprovement` for
+     * `patience` consecutive epochs.
+     *
+     * @param patience Number of epochs without improvement before stopping, 0 to disable.
+     * @param minImprovement Minimum decrease of the loss counted as an improvement.
+     */
+    void setEarlyStopping(int patience, double minImprovement);
+
+    /**
+     * @brief Enables shuffling of the training samples.
+     *
+     * When enabled, the training samples are visited in a new random order on every epoch.
+     *
+     * @param shuffle True to shuffle the training samples, false to visit them in order.
+     */
+    void setShuffle(bool shuffle);
+
+    /**
+     * @brief Seeds the pseudo-random number generator used for shuffling.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Sets the checkpoint callback.
+     *
+     * The callback is invoked after every `interval` training steps. When it returns false,
+     * fit() and resume() return TRAINING_INTERRUPTED right away, leaving the current weights
+     * in the network so that training can be resumed.
+     *
+     * @param callback The checkpoint callback, or NULL to disable it.
+     * @param interval Number of training steps between two invocations.
+     */
+    void setCheckpointCallback(diwa_checkpoint callback, int interval);
+
+    /**
+     * @brief Computes the learning rate of an epoch according to the schedule.
+     *
+     * @param epoch The zero-based epoch.
+     * @param epochs The total number of epochs of the training run.
+     * @return The learning rate to be used on the epoch.
+     */
+    double getLearningRate(int epoch, int epochs) const;
+
+    /**
+     * @brief Runs a learning rate range test.
+     *
+     * This method trains the network for a number of steps while exponentially increasing
+     * the learning rate from `minRate` to `maxRate`, and tracks the smoothed training loss.
+     * The test stops once the loss diverges. The weights of the network are restored
+     * afterwards, so the test does not affect subsequent training.
+     *
+     * @param inputs Contiguous input values of the training dataset.
+     * @param targets Contiguous target values of the training dataset.
+     * @param samples Number of samples in the training dataset.
+     * @param minRate Learning rate of the first step.
+     * @param maxRate Learning rate of the last step.
+     * @param steps Number of training steps of the test.
+     *
+     * @return The suggested learning rate, i.e. a tenth of the learning rate with the
+     *         lowest smoothed loss, or -1 if the parameters are invalid or memory
+     *         allocation failed.
+     */
+    double findLearningRate(
+        double *inputs,
+        double *targets,
+        int samples,
+        double minRate,
+        double maxRate,
+        int steps
+    );
+
+    /**
+     * @brief Trains the network over a dataset.
+     *
+     * This method trains the network on every training sample once per epoch, using the
+     * learning rate of the schedule. After each epoch, the loss over the validation dataset
+     * (or the mean training loss if no validation dataset is given) is computed. The weights
+     * of the epoch with the lowest loss are kept aside and restored when training ends.
+     *
+     * @param trainInputs Contiguous input values of the training dataset.
+     * @param trainTargets Contiguous target values of the training dataset.
+     * @param trainSamples Number of samples in the training dataset.
+     * @param validationInputs Contiguous input values of the validation dataset, or NULL.
+     * @param validationTargets Contiguous target values of the validation dataset, or NULL.
+     * @param validationSamples Number of samples in the validation dataset, or 0.
+     * @param epochs Maximum number of epochs to train.
+     *
+     * @return DiwaError indicating the training status, TRAINING_INTERRUPTED if
+     *         the checkpoint callback stopped the training.
+     */
+    DiwaError fit(
+        double *trainInputs,
+        double *trainTargets,
+        int trainSamples,
+        double *validationInputs,
+        double *validationTargets,
+        int validationSamples,
+        int epochs
+    );
+
+    /**
+     * @brief Resumes an interrupted training.
+     *
+     * This method continues the training from the epoch and sample at which it was stopped,
+     * either by the checkpoint callback or by loading a checkpoint. The arguments must be the
+     * same as those given to fit().
+     *
+     * @param trainInputs Contiguous input values of the training dataset.
+     * @param trainTargets Contiguous target values of the training dataset.
+     * @param trainSamples Number of samples in the training dataset.
+     * @param validationInputs Contiguous input values of the validation dataset, or NULL.
+     * @param validationTargets Contiguous target values of the validation dataset, or NULL.
+     * @param validationSamples Number of samples in the validation dataset, or 0.
+     * @param epochs Maximum number of epochs to train.
+     *
+     * @return DiwaError indicating the training status, TRAINING_INTERRUPTED if
+     *         the checkpoint callback stopped the training.
+     */
+    DiwaError resume(
+        double *trainInputs,
+        double *trainTargets,
+        int trainSamples,
+        double *validationInputs,
+        double *validationTargets,
+        int validationSamples,
+        int epochs
+    );
+
+    #ifdef ARDUINO
+
+    /**
+     * @brief Load training checkpoint from file in Arduino environment.
+     *
+     * This method loads the model of the checkpoint into the network, then restores the
+     * state of the trainer, after which resume() continues the interrupted training.
+     *
+     * @param checkpointFile File object representing the checkpoint file.
+     * @return DiwaError indicating the loading status.
+     */
+    DiwaError loadCheckpoint(File checkpointFile);
+
+    /**
+     * @brief Save training checkpoint to file in Arduino environment.
+     *
+     * @param checkpointFile File object representing the destination file for the checkpoint.
+     * @return DiwaError indicating the saving status.
+     */
+    DiwaError saveCheckpoint(File checkpointFile);
+
+    #elif defined(__GNUC__) || \
+        defined(__GNUG__) || \
+        defined(__clang__) || \
+        defined(_MSC_VER)
+
+    /**
+     * @brief Load training checkpoint from file in non-Arduino environment.
+     *
+     * This method loads the model of the checkpoint into the network, then restores the
+     * state of the trainer, after which resume() continues the interrupted training.
+     *
+     * @param checkpointFile Input file stream representing the checkpoint file.
+     * @return DiwaError indicating the loading status.
+     */
+    DiwaError loadCheckpoint(std::ifstream& checkpointFile);
+
+    /**
+     * @brief Save training checkpoint to file in non-Arduino environment.
+     *
+     * @param checkpointFile Output file stream representing the destination file for the checkpoint.
+     * @return DiwaError indicating the saving status.
+     */
+    DiwaError saveCheckpoint(std::ofstream& checkpointFile);
+
+    #endif
+
+    /**
+     * @brief Get the number of epochs run by the last training.
+     *
+     * @return The number of epochs run, which is lower than requested if training stopped early.
+     */
+    int getEpoch() const;
+
+    /**
+     * @brief Get the epoch with the lowest loss on the last training.
+     *
+     * @return The zero-based epoch whose weights were restored.
+     */
+    int getBestEpoch() const;
+
+    /**
+     * @brief Get the lowest loss reached on the last training.
+     *
+     * @return The loss of the epoch whose weights were restored.
+     */
+    double getBestLoss() const;
+
+    /**
+     * @brief Get the number of training steps since the start of the last training.
+     *
+     * @return The number of samples trained on, across all epochs.
+     */
+    uint64_t getStep() const;
+};
+
+#endif  // DIWA_TRAINER_H
@@ -0,0 +1,221 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa_validation.h>
+#include <diwa_dataset.h>
+
+#ifdef DIWA_THREADS
+#   include <atomic>
+#   include <thread>
+#endif
+
+DiwaCrossValidation::DiwaCrossValidation(int folds, int threads) {
+    this->folds = folds > 2 ? folds : 2;
+
+    #ifdef DIWA_THREADS
+    if(threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    #else
+    threads = 1;
+    #endif
+
+    if(threads <= 0)
+        threads = 1;
+    if(threads > this->folds)
+        threads = this->folds;
+    this->threads = threads;
+
+    this->hiddenLayers = 1;
+    this->hiddenNeurons = 8;
+
+    this->activation = DiwaActivationFunc::sigmoid;
+    this->outputMode = ACTIVATION_OUTPUT;
+    this->initialization = UNIFORM_INITIALIZATION;
+    this->seed = 0;
+
+    this->metrics = new DiwaMetrics[this->folds];
+    this->deviation = 0;
+}
+
+DiwaCrossValidation::~DiwaCrossValidation() {
+    delete[] this->metrics;
+}
+
+void DiwaCrossValidation::setTopology(int hiddenLayers, int hiddenNeurons) {
+    this->hiddenLayers = hiddenLayers;
+    this->hiddenNeurons = hiddenNeurons;
+}
+
+void DiwaCrossValidation::setActivationFunction(diwa_activation activation) {
+    this->activation = activation;
+}
+
+void DiwaCrossValidation::setOutputMode(DiwaOutputMode mode) {
+    this->outputMode = mode;
+}
+
+void DiwaCrossValidation::setWeightInitialization(DiwaInitialization initialization) {
+    this->initialization = initialization;
+}
+
+void DiwaCrossValidation::setSeed(uint64_t seed) {
+    this->seed = seed;
+}
+
+DiwaError DiwaCrossValidation::runFold(
+    DiwaDataset& training,
+    const DiwaDataset& validation,
+    DiwaMetrics& metrics,
+    double learningRate,
+    int epochs,
+    int batchSize
+) const {
+    Diwa network;
+    network.setSeed(this->seed);
+    network.setActivationFunction(this->activation);
+    network.setOutputMode(this->outputMode);
+    network.setWeightInitialization(this->initialization);
+
+    DiwaError error;
+    if((error = network.initialize(
+        training.getInputCount(),
+        this->hiddenLayers,
+        this->hiddenNeurons,
+        training.getTargetCount()
+    )) != NO_ERROR)
+        return error;
+
+    if((error = network.fit(learningRate, training, epochs, batchSize)) != NO_ERROR)
+        return error;
+
+    return network.evaluate(validation, metrics, 1);
+}
+
+DiwaError DiwaCrossValidation::run(
+    const DiwaDataset& dataset,
+    double learningRate,
+    int epochs,
+    int batchSize
+) {
+    if(dataset.getSampleCount() < this->folds)
+        return INVALID_PARAM_VALUES;
+
+    DiwaDataset *training = new DiwaDataset[this->folds];
+    DiwaDataset *validation = new DiwaDataset[this->folds];
+    DiwaError *errors = new DiwaError[this->folds];
+
+    for(int f = 0; f < this->folds; f++) {
+        errors[f] = dataset.fold(this->folds, f, training[f], validation[f]);
+        training[f].setSeed(this->seed + f + 1);
+
+        if(errors[f] == NO_ERROR)
+            errors[f] = this->metrics[f].reset(1);
+    }
+
+    #ifdef DIWA_THREADS
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        for(int f; (f = next++) < this->folds; )
+            if(errors[f] == NO_ERROR)
+                errors[f] = this->runFold(
+                    training[f], validation[f], this->metrics[f],
+                    learningRate, epochs, batchSize
+                );
+    };
+
+    std::thread *workers = new std::thread[this->threads - 1];
+    for(int t = 1; t < this->threads; t++)
+        workers[t - 1] = std::thread(work);
+
+    work();
+
+    for(int t = 1; t < this->threads; t++)
+        workers[t - 1].join();
+    delete[] workers;
+    #else
+    for(int f = 0; f < this->folds; f++)
+        if(errors[f] == NO_ERROR)
+            errors[f] = this->runFold(
+                training[f], validation[f], this->metrics[f],
+                learningRate, epochs, batchSize
+            );
+    #endif
+
+    DiwaError error = NO_ERROR;
+    for(int f = 0; f < this->folds && error == NO_ERROR; f++)
+        error = errors[f];
+
+    delete[] training;
+    delete[] validation;
+    delete[] errors;
+
+    if(error != NO_ERROR)
+        return error;
+
+    const int classes = this->metrics[0].classes;
+    if((error = this->overall.reset(classes)) != NO_ERROR)
+        return error;
+
+    double correct = 0, meanAccuracy = 0;
+    for(int f = 0; f < this->folds; f++) {
+        const DiwaMetrics& fold = this->metrics[f];
+
+        this->overall.samples += fold.samples;
+        this->overall.meanSquaredError += fold.meanSquaredError * fold.samples;
+        this->overall.crossEntropy += fold.crossEntropy * fold.samples;
+
+        for(int c = 0; c < classes * classes; c++)
+            this->overall.confusion[c] += fold.confusion[c];
+
+        correct += fold.accuracy * fold.samples;
+        meanAccuracy += fold.accuracy / this->folds;
+    }
+
+    this->overall.meanSquaredError /= this->overall.samples;
+    this->overall.crossEntropy /= this->overall.samples;
+    this->overall.accuracy = correct / this->overall.samples;
+
+    this->deviation = 0;
+    for(int f = 0; f < this->folds; f++)
+        this->deviation += (this->metrics[f].accuracy - meanAccuracy) *
+            (this->metrics[f].accuracy - meanAccuracy) / this->folds;
+    this->deviation = sqrt(this->deviation);
+
+    return NO_ERROR;
+}
+
+int DiwaCrossValidation::getFoldCount() const {
+    return this->folds;
+}
+
+const DiwaMetrics& DiwaCrossValidation::getFoldMetrics(int fold) const {
+    return this->metrics[fold < 0 ? 0 : (fold >= this->folds ? this->folds - 1 : fold)];
+}
+
+const DiwaMetrics& DiwaCrossValidation::getMetrics() const {
+    return this->overall;
+}
+
+double DiwaCrossValidation::getAccuracyDeviation() const {
+    return this->deviation;
+}
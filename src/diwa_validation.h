@@ -0,0 +1,196 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file diwa_validation.h
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief This file contains the declaration of the DiwaCrossValidation class, a
+ *        k-fold cross-validation runner for the Diwa neural network.
+ *
+ * The DiwaCrossValidation class estimates how well a network topology and training setup
+ * generalize. The dataset is cut into k folds; for every fold, a new network is trained on
+ * the other folds and evaluated on the held-out one. Every held-out sample is thus evaluated
+ * exactly once, by a network that never saw it during training.
+ *
+ * @note On desktop platforms, the folds are trained concurrently by a pool of worker threads
+ *       which take the folds one after another. Every fold trains on index views of the same
+ *       dataset, so the samples are shared read-only and never copied. On Arduino, the folds
+ *       are trained sequentially.
+ */
+
+#ifndef DIWA_VALIDATION_H
+#define DIWA_VALIDATION_H
+
+#include <diwa.h>
+#include <diwa_metrics.h>
+
+/**
+ *
+ * @class DiwaCrossValidation
+ * @brief Parallel k-fold cross-validation of a network topology.
+ *
+ * The folds are cut from the current order of the dataset, which
+ * should therefore be shuffled beforehand. Every fold network is
+ * initialized with the same seed and trained with Diwa::fit(), so
+ * the results only depend on the seed and not on the number of
+ * threads.
+ *
+ */
+class DiwaCrossValidation final {
+private:
+    int folds;              /**< Number of folds */
+    int threads;            /**< Number of worker threads */
+
+    int hiddenLayers;       /**< Number of hidden layers of the fold networks */
+    int hiddenNeurons;      /**< Number of neurons per hidden layer of the fold networks */
+
+    diwa_activation activation;         /**< Activation function of the fold networks */
+    DiwaOutputMode outputMode;          /**< Output mode of the fold networks */
+    DiwaInitialization initialization;  /**< Weight initialization of the fold networks */
+    uint64_t seed;                      /**< Seed of the weights and of the shuffling */
+
+    DiwaMetrics *metrics;   /**< Metrics of every fold on its held-out samples */
+    DiwaMetrics overall;    /**< Metrics over the held-out samples of all folds */
+    double deviation;       /**< Standard deviation of the accuracy across folds */
+
+    /**
+     * @brief Trains and evaluates the network of a fold.
+     *
+     * @param training Training view of the fold.
+     * @param validation Held-out view of the fold.
+     * @param metrics Metrics receiving the results of the fold.
+     * @param learningRate Learning rate for the training process.
+     * @param epochs Number of passes over the training view.
+     * @param batchSize Number of samples per batch.
+     * @return DiwaError indicating the status of the fold.
+     */
+    DiwaError runFold(
+        DiwaDataset& training,
+        const DiwaDataset& validation,
+        DiwaMetrics& metrics,
+        double learningRate,
+        int epochs,
+        int batchSize
+    ) const;
+
+public:
+    /**
+     * @brief Constructor for the DiwaCrossValidation class.
+     *
+     * The fold networks default to one hidden layer of 8 neurons, with the default
+     * activation function, output mode and weight initialization of Diwa.
+     *
+     * @param folds Number of folds, at least 2.
+     * @param threads Number of worker threads, or 0 for one per hardware thread.
+     */
+    DiwaCrossValidation(int folds = 5, int threads = 0);
+
+    /**
+     * @brief Destructor for the DiwaCrossValidation class.
+     *
+     * Releases the metrics of the folds.
+     */
+    ~DiwaCrossValidation();
+
+    /**
+     * @brief Sets the hidden layers of the fold networks.
+     *
+     * @param hiddenLayers Number of hidden layers.
+     * @param hiddenNeurons Number of neurons per hidden layer.
+     */
+    void setTopology(int hiddenLayers, int hiddenNeurons);
+
+    /**
+     * @brief Sets the activation function of the fold networks.
+     *
+     * @param activation The activation function, with a derivative known to DiwaActivationFunc::derivativeOf().
+     */
+    void setActivationFunction(diwa_activation activation);
+
+    /**
+     * @brief Sets the output mode of the fold networks.
+     *
+     * @param mode The output mode.
+     */
+    void setOutputMode(DiwaOutputMode mode);
+
+    /**
+     * @brief Sets the weight initialization of the fold networks.
+     *
+     * @param initialization The weight initialization scheme.
+     */
+    void setWeightInitialization(DiwaInitialization initialization);
+
+    /**
+     * @brief Sets the seed of the weights and of the shuffling of every fold.
+     *
+     * @param seed The 64-bit seed value.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Runs the cross-validation on a dataset.
+     *
+     * @param dataset The dataset, with at least as many samples as there are folds.
+     * @param learningRate Learning rate for the training process.
+     * @param epochs Number of passes over the training samples of every fold.
+     * @param batchSize Number of samples per batch.
+     * @return DiwaError indicating the status of the first fold that failed, if any.
+     */
+    DiwaError run(const DiwaDataset& dataset, double learningRate, int epochs, int batchSize);
+
+    /**
+     * @brief Get the number of folds.
+     *
+     * @return The number of folds.
+     */
+    int getFoldCount() const;
+
+    /**
+     * @brief Get the metrics of a fold on its held-out samples.
+     *
+     * @param fold Index of the fold.
+     * @return The metrics of the fold, empty if the fold did not run.
+     */
+    const DiwaMetrics& getFoldMetrics(int fold) const;
+
+    /**
+     * @brief Get the metrics over the held-out samples of all folds.
+     *
+     * Since every sample is held out exactly once, these are the metrics of the
+     * fold networks over the whole dataset, each sample being evaluated by the
+     * network that did not train on it.
+     *
+     * @return The aggregate metrics, with the confusion matrices of the folds summed.
+     */
+    const DiwaMetrics& getMetrics() const;
+
+    /**
+     * @brief Get the standard deviation of the accuracy across folds.
+     *
+     * @return The standard deviation of the fold accuracies.
+     */
+    double getAccuracyDeviation() const;
+};
+
+#endif  // DIWA_VALIDATION_H
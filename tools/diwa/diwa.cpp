@@ -0,0 +1,779 @@
+/*
+ * This file is part of the Diwa library.
+ * Copyright (c) 2024 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <diwa.h>
+#include <diwa_conv.h>
+#include <diwa_csv.h>
+#include <diwa_dataset.h>
+#include <diwa_mapped.h>
+#include <diwa_metrics.h>
+#include <diwa_npy.h>
+#include <diwa_search.h>
+#include <diwa_validation.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+
+#define MAX_COLUMNS 4096
+
+struct Options {
+    const char *inputColumns = NULL;
+    const char *targetColumns = NULL;
+    char delimiter = ',';
+    bool header = true;
+
+    int hiddenNeurons = 16;
+    int hiddenLayers = 1;
+    int epochs = 10;
+    int batchSize = 32;
+    int threads = 0;
+    double learningRate = 0.1;
+    double validation = 0;
+    int folds = 5;
+    double latency = 0;
+    long memory = 0;
+    const char *model = NULL;
+    uint64_t seed = 1;
+    bool softmax = false;
+    double seconds = 2;
+};
+
+static void usage() {
+    cout << "Usage:" << endl
+        << "  diwa train <dataset> <model> [options]   Train a model and save it" << endl
+        << "  diwa eval <model> <dataset> [options]    Evaluate a model on a dataset" << endl
+        << "  diwa cv <dataset> [options]              Cross-validate a topology on a dataset" << endl
+        << "  diwa search <dataset> [options]          Find the most accurate topology within budget" << endl
+        << "  diwa bench <inputs> <hidden layers> <hidden neurons> <outputs> [options]" << endl
+        << "                                           Measure inference and training throughput" << endl
+        << "  diwa predict <model> <inputs.npy> <outputs.npy> [--float32]" << endl
+        << "                                           Infer every row of a NumPy array" << endl
+        << "  diwa inspect <model>                     Print the header of a model file" << endl
+        << endl
+        << "Datasets are CSV files, or .diwd files written by DiwaMappedDataset. Both are" << endl
+        << "loaded fully into memory, .diwd files included, so they must fit in RAM." << endl
+        << endl
+        << "Options:" << endl
+        << "  --inputs <columns>     Input columns, e.g. 0-3,5 (default: all but the targets)" << endl
+        << "  --targets <columns>    Target columns (default: the last column)" << endl
+        << "  --delimiter <char>     Field delimiter, or \"tab\" (default: ,)" << endl
+        << "  --no-header            The first line of the CSV file holds values" << endl
+        << "  --layers <n>           Hidden layers (default: 1)" << endl
+        << "  --neurons <n>          Neurons per hidden layer (default: 16)" << endl
+        << "  --epochs <n>           Passes over the dataset (default: 10)" << endl
+        << "  --lr <rate>            Learning rate (default: 0.1)" << endl
+        << "  --batch <n>            Samples per batch (default: 32)" << endl
+        << "  --threads <n>          Worker threads, 0 for all cores (default: 0)" << endl
+        << "  --validation <frac>    Fraction of the samples held out for evaluation" << endl
+        << "  --folds <n>            Folds of the cross-validation (default: 5)" << endl
+        << "  --latency <us>         Maximum inference latency of the search" << endl
+        << "  --memory <bytes>       Maximum inference memory of the search" << endl
+        << "  --save <model>         Save the best model found by the search" << endl
+        << "  --seed <n>             Seed of the initialization and shuffling (default: 1)" << endl
+        << "  --softmax              Train a softmax classifier" << endl
+        << "  --seconds <s>          Duration of each benchmark (default: 2)" << endl;
+}
+
+static bool parseOptions(int argc, char **argv, Options& options) {
+    for(int i = 0; i < argc; i++) {
+        const char *name = argv[i];
+
+        if(strcmp(name, "--no-header") == 0) {
+            options.header = false;
+            continue;
+        }
+        else if(strcmp(name, "--softmax") == 0) {
+            options.softmax = true;
+            continue;
+        }
+
+        if(i + 1 >= argc) {
+            cout << "Unknown or incomplete option: " << name << endl;
+            return false;
+        }
+
+        const char *value = argv[++i];
+        if(strcmp(name, "--inputs") == 0)
+            options.inputColumns = value;
+        else if(strcmp(name, "--targets") == 0)
+            options.targetColumns = value;
+        else if(strcmp(name, "--delimiter") == 0)
+            options.delimiter = strcmp(value, "tab") == 0 ? '\t' : value[0];
+        else if(strcmp(name, "--layers") == 0)
+            options.hiddenLayers = atoi(value);
+        else if(strcmp(name, "--neurons") == 0)
+            options.hiddenNeurons = atoi(value);
+        else if(strcmp(name, "--epochs") == 0)
+            options.epochs = atoi(value);
+        else if(strcmp(name, "--lr") == 0)
+            options.learningRate = atof(value);
+        else if(strcmp(name, "--batch") == 0)
+            options.batchSize = atoi(value);
+        else if(strcmp(name, "--threads") == 0)
+            options.threads = atoi(value);
+        else if(strcmp(name, "--validation") == 0)
+            options.validation = atof(value);
+        else if(strcmp(name, "--folds") == 0)
+            options.folds = atoi(value);
+        else if(strcmp(name, "--latency") == 0)
+            options.latency = atof(value);
+        else if(strcmp(name, "--memory") == 0)
+            options.memory = atol(value);
+        else if(strcmp(name, "--save") == 0)
+            options.model = value;
+        else if(strcmp(name, "--seed") == 0)
+            options.seed = strtoull(value, NULL, 10);
+        else if(strcmp(name, "--seconds") == 0)
+            options.seconds = atof(value);
+        else {
+            cout << "Unknown option: " << name << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Parses a list of columns such as "0-3,5", returning the number of columns or -1
+static int parseColumns(const char *list, int *columns) {
+    int count = 0;
+
+    while(*list) {
+        char *end;
+        long first = strtol(list, &end, 10), last = first;
+
+        if(end == list || first < 0)
+            return -1;
+
+        if(*end == '-') {
+            list = end + 1;
+            last = strtol(list, &end, 10);
+
+            if(end == list || last < first)
+                return -1;
+        }
+
+        for(long column = first; column <= last; column++) {
+            if(count == MAX_COLUMNS)
+                return -1;
+            columns[count++] = (int) column;
+        }
+
+        if(*end == ',')
+            end++;
+        else if(*end != '\0')
+            return -1;
+        list = end;
+    }
+
+    return count;
+}
+
+// Counts the fields of the first line of a CSV file
+static int countFields(const char *path, char delimiter) {
+    ifstream file(path);
+    string line;
+
+    if(!getline(file, line))
+        return -1;
+
+    int count = 1;
+    for(char c : line)
+        if(c == delimiter)
+            count++;
+    return count;
+}
+
+static bool endsWith(const char *text, const char *suffix) {
+    size_t length = strlen(text), suffixLength = strlen(suffix);
+    return length >= suffixLength && strcmp(text + length - suffixLength, suffix) == 0;
+}
+
+static bool loadDataset(const char *path, const Options& options, DiwaDataset& dataset) {
+    #if defined(__unix__) || defined(__APPLE__)
+    // Every subcommand works on a DiwaDataset, so the mapped samples are
+    // copied into memory instead of being streamed from the file
+    if(endsWith(path, ".diwd")) {
+        DiwaMappedDataset mapped;
+
+        if(mapped.open(path) != NO_ERROR ||
+            dataset.initialize(
+                mapped.getSampleCount(),
+                mapped.getInputCount(),
+                mapped.getTargetCount()
+            ) != NO_ERROR) {
+            cout << "Failed to read dataset: " << path << endl;
+            return false;
+        }
+
+        for(int i = 0; i < mapped.getSampleCount(); i++)
+            dataset.setRow(i, mapped.getInputs(i), mapped.getTargets(i));
+        return true;
+    }
+    #endif
+
+    static int inputs[MAX_COLUMNS], targets[MAX_COLUMNS];
+    int inputCount, targetCount = 1;
+
+    const int fields = countFields(path, options.delimiter);
+    if(fields < 0) {
+        cout << "Failed to read dataset: " << path << endl;
+        return false;
+    }
+
+    if(options.targetColumns != NULL)
+        targetCount = parseColumns(options.targetColumns, targets);
+    else targets[0] = fields - 1;
+
+    if(options.inputColumns != NULL)
+        inputCount = parseColumns(options.inputColumns, inputs);
+    else {
+        inputCount = 0;
+
+        for(int column = 0; column < fields && targetCount > 0; column++)
+            if(find(targets, targets + targetCount, column) == targets + targetCount)
+                inputs[inputCount++] = column;
+    }
+
+    DiwaCsvReader reader;
+    reader.setDelimiter(options.delimiter);
+    reader.setHeader(options.header);
+    reader.setThreads(options.threads);
+
+    if(inputCount <= 0 || targetCount <= 0 ||
+        reader.setInputColumns(inputs, inputCount) != NO_ERROR ||
+        reader.setTargetColumns(targets, targetCount) != NO_ERROR) {
+        cout << "Invalid input or target columns" << endl;
+        return false;
+    }
+
+    if(reader.read(path, dataset) != NO_ERROR) {
+        cout << "Failed to read dataset: " << path;
+        if(reader.getErrorRow() >= 0)
+            cout << " (row " << reader.getErrorRow() << ")";
+
+        cout << endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Prints the metrics of a network on a dataset, along with the
+// confusion matrix when it is small enough to be readable
+static bool evaluate(Diwa& network, const DiwaDataset& dataset, int threads) {
+    DiwaMetrics metrics;
+
+    if(network.evaluate(dataset, metrics, threads) != NO_ERROR) {
+        cout << "Failed to evaluate neural network" << endl;
+        return false;
+    }
+
+    cout << "Samples:       " << metrics.getSampleCount() << endl
+        << "MSE:           " << setprecision(6) << metrics.getMeanSquaredError() << endl
+        << "Cross-entropy: " << metrics.getCrossEntropy() << endl
+        << "Accuracy:      " << fixed << setprecision(2)
+        << 100.0 * metrics.getAccuracy() << "%" << endl;
+    cout.unsetf(ios::floatfield);
+
+    const int classes = metrics.getClassCount();
+    if(classes > 10)
+        return true;
+
+    cout << endl << "Confusion matrix (expected by predicted):" << endl;
+    for(int expected = 0; expected < classes; expected++) {
+        for(int predicted = 0; predicted < classes; predicted++)
+            cout << setw(10) << metrics.getConfusion(expected, predicted);
+        cout << endl;
+    }
+
+    return true;
+}
+
+static int train(int argc, char **argv) {
+    Options options;
+    if(argc < 2 || !parseOptions(argc - 2, argv + 2, options)) {
+        usage();
+        return 1;
+    }
+
+    DiwaDataset dataset, training, validation;
+    DiwaDataset *samples = &dataset;
+    dataset.setSeed(options.seed);
+
+    if(!loadDataset(argv[0], options, dataset))
+        return 1;
+
+    if(options.validation > 0 && options.validation < 1) {
+        dataset.shuffle();
+
+        if(dataset.split(options.validation, training, validation) != NO_ERROR) {
+            cout << "Failed to split dataset" << endl;
+            return 1;
+        }
+
+        training.setSeed(options.seed + 1);
+        samples = &training;
+    }
+
+    Diwa network;
+    network.setSeed(options.seed);
+
+    if(network.initialize(
+        dataset.getInputCount(),
+        options.hiddenLayers,
+        options.hiddenNeurons,
+        dataset.getTargetCount()
+    ) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        return 1;
+    }
+
+    if(options.softmax)
+        network.setOutputMode(SOFTMAX_OUTPUT);
+
+    const int threads = options.threads > 0 ? options.threads :
+        (int) thread::hardware_concurrency();
+    cout << samples->getSampleCount() << " training samples, "
+        << dataset.getInputCount() << " inputs, "
+        << dataset.getTargetCount() << " outputs, "
+        << (threads > 0 ? threads : 1) << " threads" << endl;
+
+    for(int epoch = 1; epoch <= options.epochs; epoch++) {
+        steady_clock::time_point start = steady_clock::now();
+
+        if(network.fit(
+            options.learningRate,
+            *samples, 1,
+            options.batchSize,
+            options.threads
+        ) != NO_ERROR) {
+            cout << "Failed to train neural network" << endl;
+            return 1;
+        }
+
+        cout << "Epoch " << epoch << "/" << options.epochs << ": "
+            << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << " ms" << endl;
+    }
+
+    ofstream file(argv[1], ios::binary);
+    if(network.saveToFile(file) != NO_ERROR) {
+        cout << "Failed to save model: " << argv[1] << endl;
+        return 1;
+    }
+
+    file.close();
+    cout << "Saved " << argv[1] << endl;
+
+    if(validation.getSampleCount() > 0) {
+        cout << endl << "Validation:" << endl;
+
+        if(!evaluate(network, validation, options.threads))
+            return 1;
+    }
+
+    return 0;
+}
+
+static int eval(int argc, char **argv) {
+    Options options;
+    if(argc < 2 || !parseOptions(argc - 2, argv + 2, options)) {
+        usage();
+        return 1;
+    }
+
+    Diwa network;
+    ifstream file(argv[0], ios::binary);
+
+    if(network.loadFromFile(file) != NO_ERROR) {
+        cout << "Failed to load model: " << argv[0] << endl;
+        return 1;
+    }
+
+    DiwaDataset dataset;
+    if(!loadDataset(argv[1], options, dataset))
+        return 1;
+
+    if(dataset.getInputCount() != network.getInputNeurons() ||
+        dataset.getTargetCount() != network.getOutputNeurons()) {
+        cout << "The dataset has " << dataset.getInputCount() << " inputs and "
+            << dataset.getTargetCount() << " targets, the model "
+            << network.getInputNeurons() << " inputs and "
+            << network.getOutputNeurons() << " outputs" << endl;
+        return 1;
+    }
+
+    return evaluate(network, dataset, options.threads) ? 0 : 1;
+}
+
+static int crossValidate(int argc, char **argv) {
+    Options options;
+    if(argc < 1 || !parseOptions(argc - 1, argv + 1, options)) {
+        usage();
+        return 1;
+    }
+
+    DiwaDataset dataset;
+    dataset.setSeed(options.seed);
+
+    if(!loadDataset(argv[0], options, dataset))
+        return 1;
+    dataset.shuffle();
+
+    DiwaCrossValidation validation(options.folds, options.threads);
+    validation.setTopology(options.hiddenLayers, options.hiddenNeurons);
+    validation.setSeed(options.seed);
+
+    if(options.softmax)
+        validation.setOutputMode(SOFTMAX_OUTPUT);
+
+    steady_clock::time_point start = steady_clock::now();
+    if(validation.run(
+        dataset,
+        options.learningRate,
+        options.epochs,
+        options.batchSize
+    ) != NO_ERROR) {
+        cout << "Failed to cross-validate neural network" << endl;
+        return 1;
+    }
+
+    cout << validation.getFoldCount() << " folds of " << options.hiddenLayers << "x"
+        << options.hiddenNeurons << " hidden neurons in "
+        << duration_cast<milliseconds>(steady_clock::now() - start).count()
+        << " ms" << endl << endl;
+
+    for(int fold = 0; fold < validation.getFoldCount(); fold++) {
+        const DiwaMetrics& metrics = validation.getFoldMetrics(fold);
+
+        cout << "Fold " << setw(2) << fold + 1 << ": " << setw(7) << metrics.getSampleCount()
+            << " samples, MSE " << setprecision(6) << metrics.getMeanSquaredError()
+            << ", cross-entropy " << metrics.getCrossEntropy()
+            << ", accuracy " << fixed << setprecision(2)
+            << 100.0 * metrics.getAccuracy() << "%" << endl;
+        cout.unsetf(ios::floatfield);
+    }
+
+    const DiwaMetrics& metrics = validation.getMetrics();
+    cout << endl << "Overall: MSE " << setprecision(6) << metrics.getMeanSquaredError()
+        << ", cross-entropy " << metrics.getCrossEntropy()
+        << ", accuracy " << fixed << setprecision(2) << 100.0 * metrics.getAccuracy()
+        << "% (+/- " << 100.0 * validation.getAccuracyDeviation() << "%)" << endl;
+
+    return 0;
+}
+
+static int search(int argc, char **argv) {
+    Options options;
+    if(argc < 1 || !parseOptions(argc - 1, argv + 1, options)) {
+        usage();
+        return 1;
+    }
+
+    DiwaDataset dataset;
+    dataset.setSeed(options.seed);
+
+    if(!loadDataset(argv[0], options, dataset))
+        return 1;
+    dataset.shuffle();
+
+    DiwaTopologySearch search(options.threads);
+    search.setLatencyBudget(options.latency);
+    search.setMemoryBudget(options.memory > 0 ? (size_t) options.memory : 0);
+    search.setSeed(options.seed);
+
+    if(options.softmax)
+        search.setOutputMode(SOFTMAX_OUTPUT);
+
+    if(search.search(
+        dataset,
+        options.learningRate,
+        options.epochs,
+        options.batchSize,
+        options.validation > 0 && options.validation < 1 ? options.validation : 0.2
+    ) != NO_ERROR) {
+        cout << "Failed to search topologies" << endl;
+        return 1;
+    }
+
+    cout << "Hidden    Latency     Memory   Accuracy" << endl;
+    for(int i = 0; i < search.getCandidateCount(); i++) {
+        cout << setw(2) << search.getHiddenLayers(i) << " x " << left << setw(4)
+            << search.getHiddenNeurons(i) << right << fixed << setprecision(3)
+            << setw(9) << search.getLatency(i) << " us" << setw(9)
+            << search.getMemory(i) << " B ";
+
+        if(search.getAccuracy(i) < 0)
+            cout << "over budget";
+        else cout << setprecision(2) << setw(9) << 100.0 * search.getAccuracy(i) << "%";
+
+        cout << (i == search.getBestCandidate() ? "  <- best" : "") << endl;
+    }
+    cout.unsetf(ios::floatfield);
+
+    if(search.getBestCandidate() < 0) {
+        cout << "No topology within budget" << endl;
+        return 1;
+    }
+
+    if(options.model != NULL) {
+        Diwa network;
+        ofstream file(options.model, ios::binary);
+
+        if(search.getBestNetwork(network) != NO_ERROR ||
+            network.saveToFile(file) != NO_ERROR) {
+            cout << "Failed to save model: " << options.model << endl;
+            return 1;
+        }
+
+        cout << "Saved " << options.model << endl;
+    }
+
+    return 0;
+}
+
+static int bench(int argc, char **argv) {
+    Options options;
+    if(argc < 4 || !parseOptions(argc - 4, argv + 4, options)) {
+        usage();
+        return 1;
+    }
+
+    const int inputCount = atoi(argv[0]), outputCount = atoi(argv[3]);
+    Diwa network;
+    network.setSeed(options.seed);
+
+    if(network.initialize(inputCount, atoi(argv[1]), atoi(argv[2]), outputCount) != NO_ERROR) {
+        cout << "Failed to initialize neural network" << endl;
+        return 1;
+    }
+
+    // Random samples, enough to train on full batches
+    const int samples = options.batchSize > 1024 ? options.batchSize : 1024;
+    DiwaDataset dataset;
+    DiwaRandom randomizer;
+
+    randomizer.seed(options.seed);
+    dataset.setSeed(options.seed);
+
+    if(dataset.initialize(samples, inputCount, outputCount) != NO_ERROR) {
+        cout << "Failed to allocate samples" << endl;
+        return 1;
+    }
+
+    for(int i = 0; i < samples * inputCount; i++)
+        dataset.getInputs()[i] = randomizer.nextUniform(-1, 1);
+    for(int i = 0; i < samples * outputCount; i++)
+        dataset.getTargets()[i] = randomizer.nextDouble();
+
+    cout << "Topology: " << inputCount << "-" << argv[1] << "x" << argv[2]
+        << "-" << outputCount << ", " << network.getWeightCount() << " weights" << endl;
+
+    long inferences = 0;
+    steady_clock::time_point start = steady_clock::now();
+    double elapsed;
+
+    do {
+        for(int i = 0; i < samples; i++)
+            network.inference(dataset.getSampleInputs(i));
+
+        inferences += samples;
+        elapsed = duration<double>(steady_clock::now() - start).count();
+    } while(elapsed < options.seconds);
+
+    cout << "Inference: " << fixed << setprecision(0) << inferences / elapsed
+        << " samples/s (" << setprecision(3) << 1e6 * elapsed / inferences
+        << " us/sample)" << endl;
+
+    long trained = 0;
+    start = steady_clock::now();
+
+    do {
+        if(network.fit(
+            options.learningRate,
+            dataset, 1,
+            options.batchSize,
+            options.threads
+        ) != NO_ERROR) {
+            cout << "Failed to train neural network" << endl;
+            return 1;
+        }
+
+        trained += samples;
+        elapsed = duration<double>(steady_clock::now() - start).count();
+    } while(elapsed < options.seconds);
+
+    cout << "Training:  " << setprecision(0) << trained / elapsed
+        << " samples/s (batch " << options.batchSize << ", "
+        << (options.threads > 0 ? to_string(options.threads) : "all") << " threads)" << endl;
+    return 0;
+}
+
+static int predict(int argc, char **argv) {
+    #if defined(__unix__) || defined(__APPLE__)
+    if(argc < 3 || (argc > 3 && strcmp(argv[3], "--float32") != 0)) {
+        usage();
+        return 1;
+    }
+
+    Diwa network;
+    ifstream file(argv[0], ios::binary);
+
+    if(network.loadFromFile(file) != NO_ERROR) {
+        cout << "Failed to load model: " << argv[0] << endl;
+        return 1;
+    }
+
+    DiwaNpy inputs, outputs;
+    if(inputs.open(argv[1]) != NO_ERROR) {
+        cout << "Failed to open array: " << argv[1] << endl;
+        return 1;
+    }
+
+    if(outputs.create(argv[2], inputs.getRows(), network.getOutputNeurons(), argc > 3) != NO_ERROR) {
+        cout << "Failed to create array: " << argv[2] << endl;
+        return 1;
+    }
+
+    steady_clock::time_point start = steady_clock::now();
+    if(inputs.inference(network, outputs) != NO_ERROR) {
+        cout << "The array has " << inputs.getColumns() << " columns, the model "
+            << network.getInputNeurons() << " inputs" << endl;
+        return 1;
+    }
+
+    cout << "Inferred " << inputs.getRows() << " rows in "
+        << duration_cast<milliseconds>(steady_clock::now() - start).count()
+        << " ms" << endl;
+    return 0;
+    #else
+    (void) argc;
+    (void) argv;
+
+    cout << "NumPy arrays are not supported on this platform" << endl;
+    return 1;
+    #endif
+}
+
+static int inspect(int argc, char **argv) {
+    if(argc < 1) {
+        usage();
+        return 1;
+    }
+
+    ifstream file(argv[0], ios::binary);
+    if(!file.is_open()) {
+        cout << "Failed to open model: " << argv[0] << endl;
+        return 1;
+    }
+
+    uint8_t magic[4], field[8];
+    int header[6];
+
+    file.read(reinterpret_cast<char*>(magic), 4);
+    if(!file || memcmp(magic, "diwa", 4) != 0) {
+        cout << "Not a Diwa model file: " << argv[0] << endl;
+        return 1;
+    }
+
+    for(int i = 0; i < 6; i++) {
+        file.read(reinterpret_cast<char*>(field), 4);
+        header[i] = DiwaConv::u8aToInt(field);
+    }
+
+    if(!file) {
+        cout << "Truncated model file: " << argv[0] << endl;
+        return 1;
+    }
+
+    cout << "Input neurons:  " << header[0] << endl
+        << "Hidden neurons: " << header[1] << endl
+        << "Hidden layers:  " << header[2] << endl
+        << "Output neurons: " << header[3] << endl
+        << "Weights:        " << header[4] << endl
+        << "Neurons:        " << header[5] << endl
+        << "Inference:      " << Diwa::getFootprint(
+            header[0], header[2], header[1], header[3]
+        ) << " bytes" << endl
+        << "Training:       " << Diwa::getFootprint(
+            header[0], header[2], header[1], header[3], true
+        ) << " bytes" << endl;
+
+    file.seekg(8 * (streamoff) header[4], ios::cur);
+    if(!file) {
+        cout << "Truncated model file: " << argv[0] << endl;
+        return 1;
+    }
+
+    char tag[5] = {0};
+    while(file.read(tag, 4)) {
+        file.read(reinterpret_cast<char*>(field), 4);
+        const int length = DiwaConv::u8aToInt(field);
+
+        cout << "Section \"" << tag << "\": " << length << " bytes";
+        if(memcmp(tag, "outp", 4) == 0 && length == 4) {
+            file.read(reinterpret_cast<char*>(field), 4);
+            cout << ", " << (DiwaConv::u8aToInt(field) == SOFTMAX_OUTPUT ?
+                "softmax" : "activation") << " output";
+        }
+        else file.seekg(length, ios::cur);
+
+        cout << endl;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if(argc < 2) {
+        usage();
+        return 1;
+    }
+
+    if(strcmp(argv[1], "train") == 0)
+        return train(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "eval") == 0)
+        return eval(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "cv") == 0)
+        return crossValidate(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "search") == 0)
+        return search(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "bench") == 0)
+        return bench(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "predict") == 0)
+        return predict(argc - 2, argv + 2);
+    else if(strcmp(argv[1], "inspect") == 0)
+        return inspect(argc - 2, argv + 2);
+
+    usage();
+    return 1;
+}